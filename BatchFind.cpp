@@ -0,0 +1,4 @@
+// Batched, interleaved lookups in ListNode lists and TreeNode trees.
+// SPDX-License-Identifier: 0BSD
+
+#include "BatchFind.hpp"
@@ -0,0 +1,177 @@
+// Batched lookups in ListNode lists and TreeNode search trees that run many
+// searches at once, interleaved, so their cache misses overlap.
+//
+// Copyright (c) 2018 Eliah Kagan
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+// SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+// OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+// CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef HAVE_POOL_BATCHFIND_HPP_
+#define HAVE_POOL_BATCHFIND_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <vector>
+#include "ListNode.hpp"
+#include "TreeNode.hpp"
+
+namespace ek {
+    namespace detail {
+        // How many lookups are in flight at once, by default. This is about
+        // how many cache misses a core can have outstanding.
+        inline constexpr std::size_t lookup_group = 16u;
+
+        // Asks for the cache line at p to be loaded, without waiting for it.
+        // This is only a hint, and p may be null.
+        inline void prefetch(const void* const p) noexcept
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            __builtin_prefetch(p);
+#else
+            static_cast<void>(p);
+#endif
+        }
+
+        // Runs lookups 0 through n - 1, up to group at a time, as
+        // interleaved state machines. start(i) returns lookup i's state,
+        // having prefetched the first node it will look at. step(state)
+        // looks at that node and either finishes, returning true, or moves
+        // on to a next node, prefetches it, and returns false. Lookups take
+        // steps in turn, so by the time one looks at the node it prefetched,
+        // that node has had group - 1 other steps' time to arrive in cache.
+        // A finished lookup's slot goes to the next lookup not yet started.
+        template<typename Start, typename Step>
+        void interleave(const std::size_t n, const std::size_t group,
+                        Start start, Step step)
+        {
+            const auto width = std::min(std::max(group, std::size_t{1u}), n);
+
+            std::vector<decltype(start(std::size_t{}))> slots;
+            slots.reserve(width);
+
+            auto next = std::size_t{0u};
+            while (next != width) slots.push_back(start(next++));
+
+            while (!empty(slots)) {
+                for (auto s = std::size_t{0u}; s < size(slots); ) {
+                    if (!step(slots[s])) {
+                        ++s;
+                    } else if (next != n) {
+                        slots[s++] = start(next++);
+                    } else {
+                        slots[s] = slots.back();
+                        slots.pop_back();
+                    }
+                }
+            }
+        }
+    }
+
+    // For each head in [first, last) and the key at the same position in the
+    // range starting at keys, finds the first node with that key in the list
+    // at that head, as find_node would, or null if there is none. The lookups
+    // run group at a time, interleaved, so while one waits for its next node
+    // to arrive in cache the others make progress. This is much faster than
+    // looking up each key in turn when the nodes are not already in cache.
+    // To look up many keys in one list, pass the same head for each key.
+    template<typename I1, typename I2>
+    std::vector<typename std::iterator_traits<I1>::value_type>
+    find_nodes(I1 first, const I1 last, I2 keys,
+               const std::size_t group = detail::lookup_group)
+    {
+        using P = typename std::iterator_traits<I1>::value_type;
+
+        struct Lookup {
+            P node;
+            I2 key;
+            std::size_t index;
+        };
+
+        std::vector<P> ret (static_cast<std::size_t>(
+                                    std::distance(first, last)));
+
+        const auto start = [&first, &keys](const std::size_t index) {
+            const Lookup lookup {*first++, keys++, index};
+            detail::prefetch(lookup.node);
+            return lookup;
+        };
+
+        const auto step = [&ret](Lookup& lookup) {
+            if (!lookup.node || lookup.node->key == *lookup.key) {
+                ret[lookup.index] = lookup.node;
+                return true;
+            }
+
+            lookup.node = lookup.node->next;
+            detail::prefetch(lookup.node);
+            return false;
+        };
+
+        detail::interleave(size(ret), group, start, step);
+        return ret;
+    }
+
+    // For each key in [first, last), finds a node with an equivalent key in
+    // the binary search tree ordered by f, as tree_find would, or null if
+    // there is none. Like find_nodes, this runs group lookups interleaved.
+    // N is TreeNode<T> or const TreeNode<T>.
+    template<typename N, typename I, typename F>
+    std::vector<N*> tree_find_nodes(N* const root, I first, const I last,
+                                    const F f,
+                                    const std::size_t group
+                                        = detail::lookup_group)
+    {
+        struct Lookup {
+            N* node;
+            I key;
+            std::size_t index;
+        };
+
+        std::vector<N*> ret (static_cast<std::size_t>(
+                                    std::distance(first, last)));
+
+        const auto start = [root, &first](const std::size_t index) {
+            return Lookup{root, first++, index};
+        };
+
+        const auto step = [&ret, f](Lookup& lookup) {
+            const auto node = lookup.node;
+            if (!node) return true;
+
+            if (f(*lookup.key, node->key)) {
+                lookup.node = node->left;
+            } else if (f(node->key, *lookup.key)) {
+                lookup.node = node->right;
+            } else {
+                ret[lookup.index] = node;
+                return true;
+            }
+
+            detail::prefetch(lookup.node);
+            return false;
+        };
+
+        detail::prefetch(root);
+        detail::interleave(size(ret), group, start, step);
+        return ret;
+    }
+
+    template<typename N, typename I>
+    inline std::vector<N*> tree_find_nodes(N* const root, const I first,
+                                           const I last)
+    {
+        return tree_find_nodes(root, first, last, std::less{});
+    }
+}
+
+#endif // ! HAVE_POOL_BATCHFIND_HPP_
@@ -0,0 +1,4 @@
+// A blocked Bloom filter and a list handle guarded by one.
+// SPDX-License-Identifier: 0BSD
+
+#include "BloomFilter.hpp"
@@ -0,0 +1,353 @@
+// A blocked Bloom filter, and a list handle that keeps one over its keys so
+// that most lookups of absent keys return without walking the list.
+//
+// Copyright (c) 2018 Eliah Kagan
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+// SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+// OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+// CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef HAVE_POOL_BLOOMFILTER_HPP_
+#define HAVE_POOL_BLOOMFILTER_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Hash.hpp"
+#include "List.hpp"
+#include "ListNode.hpp"
+#include "Pool.hpp"
+
+namespace ek {
+    // A Bloom filter whose bits for each key all lie in one 512-bit block (a
+    // typical cache line), so a query touches one cache line. This raises
+    // the false positive rate slightly above that of a classic Bloom filter
+    // with the same number of bits, which the sizing accounts for roughly by
+    // allotting a few percent more bits.
+    template<typename T, typename H = std::hash<T>>
+    class BloomFilter {
+    public:
+        // Sizes the filter for about expected_count keys with about the given
+        // false positive rate, which must be strictly between 0 and 1.
+        explicit BloomFilter(std::size_t expected_count,
+                             double false_positive_rate = 0.01,
+                             H hash = H{});
+
+        void insert(const T& key);
+
+        // False means the key was never inserted. True means it may have been.
+        bool may_contain(const T& key) const;
+
+        void clear() noexcept;
+
+        // Clears the filter and sizes it anew for about expected_count keys.
+        void resize(std::size_t expected_count);
+
+        std::size_t bit_count() const noexcept { return blocks_.size() * 512u; }
+        unsigned hash_count() const noexcept { return hash_count_; }
+
+        double false_positive_rate() const noexcept { return rate_; }
+
+        const H& hash_function() const noexcept { return hash_; }
+
+    private:
+        using Block = std::array<std::uint64_t, 8u>;
+
+        // Calls f(word, mask) for each of the key's bits, in its block.
+        template<typename F>
+        void for_each_bit(const T& key, F f) const;
+
+        std::vector<Block> blocks_;
+        unsigned hash_count_ {};
+        double rate_;
+        H hash_;
+    };
+
+    template<typename T, typename H>
+    BloomFilter<T, H>::BloomFilter(const std::size_t expected_count,
+                                   const double false_positive_rate,
+                                   const H hash)
+        : rate_{false_positive_rate}, hash_{hash}
+    {
+        if (!(false_positive_rate > 0.0 && false_positive_rate < 1.0)) {
+            throw std::invalid_argument{
+                    "false positive rate must be between 0 and 1"};
+        }
+
+        resize(expected_count);
+    }
+
+    template<typename T, typename H>
+    void BloomFilter<T, H>::resize(const std::size_t expected_count)
+    {
+        // The optimal number of bits per key is -log2(p) / ln 2, and of hash
+        // functions is -log2(p). Blocking costs a little, so add 5% more bits.
+        const auto log2_rate = -std::log2(rate_);
+        const auto bits = 1.05 * log2_rate / std::log(2.0)
+                            * static_cast<double>(std::max(expected_count,
+                                                           std::size_t{1u}));
+
+        blocks_.assign(static_cast<std::size_t>(std::ceil(bits / 512.0)),
+                       Block{});
+        hash_count_ = static_cast<unsigned>(
+                std::clamp(std::lround(log2_rate), 1L, 16L));
+    }
+
+    template<typename T, typename H>
+    void BloomFilter<T, H>::insert(const T& key)
+    {
+        for_each_bit(key, [this](const std::size_t block,
+                                 const std::size_t word,
+                                 const std::uint64_t mask) noexcept {
+            blocks_[block][word] |= mask;
+        });
+    }
+
+    template<typename T, typename H>
+    bool BloomFilter<T, H>::may_contain(const T& key) const
+    {
+        auto ret = true;
+
+        for_each_bit(key, [this, &ret](const std::size_t block,
+                                       const std::size_t word,
+                                       const std::uint64_t mask) noexcept {
+            ret &= (blocks_[block][word] & mask) != 0u;
+        });
+
+        return ret;
+    }
+
+    template<typename T, typename H>
+    void BloomFilter<T, H>::clear() noexcept
+    {
+        std::fill(begin(blocks_), end(blocks_), Block{});
+    }
+
+    template<typename T, typename H>
+    template<typename F>
+    void BloomFilter<T, H>::for_each_bit(const T& key, F f) const
+    {
+        // One mixed hash picks the block. Another gives two 32-bit values
+        // for double hashing within it.
+        const auto h = detail::mix_hash(hash_(key));
+        const auto block = h % blocks_.size();
+
+        const auto g = static_cast<std::uint64_t>(
+                detail::mix_hash(h ^ 0x9e3779b97f4a7c15u));
+        const auto h1 = static_cast<std::uint32_t>(g);
+        const auto h2 = static_cast<std::uint32_t>(g >> 32u) | 1u;
+
+        for (auto i = 0u; i != hash_count_; ++i) {
+            const auto bit = (h1 + i * h2) & 511u;
+            f(block, bit / 64u, std::uint64_t{1u} << (bit % 64u));
+        }
+    }
+
+    // Like a List<T>, a BloomList<T> does not own its nodes. Its filter is
+    // kept current by its constructors and by push_front, push_back, concat,
+    // merge, and split, and it is rebuilt larger when the list outgrows it,
+    // to keep the false positive rate near what was asked for. Bloom filters
+    // don't support removal, so after the list's nodes are changed or
+    // removed some other way, the filter must be rebuilt, though until then
+    // lookups are still correct if only keys were removed.
+    template<typename T, typename H = std::hash<T>>
+    class BloomList {
+    public:
+        using iterator = typename List<T>::iterator;
+
+        explicit BloomList(const double false_positive_rate = 0.01,
+                           const H hash = H{})
+            : filter_{0u, false_positive_rate, hash} { }
+
+        // Adopts an existing list.
+        explicit BloomList(const List<T>& list,
+                           const double false_positive_rate = 0.01,
+                           const H hash = H{})
+            : list_{list}, filter_{list.size(), false_positive_rate, hash}
+        {
+            for (const auto& key : list_) filter_.insert(key);
+        }
+
+        // Makes the list first, so [first, last) is read once and may be a
+        // single-pass input range.
+        template<typename I,
+                 typename = std::enable_if_t<std::is_same_v<
+                        typename std::iterator_traits<I>::value_type, T>>>
+        BloomList(Pool<ListNode<T>>& pool, I first, I last,
+                  double false_positive_rate = 0.01, H hash = H{});
+
+        BloomList(Pool<ListNode<T>>& pool, std::initializer_list<T> ilist,
+                  const double false_positive_rate = 0.01, const H hash = H{})
+            : BloomList{pool, std::cbegin(ilist), std::cend(ilist),
+                        false_positive_rate, hash} { }
+
+        const List<T>& list() const noexcept { return list_; }
+        ListNode<T>* head() const noexcept { return list_.head(); }
+        std::size_t size() const noexcept { return list_.size(); }
+        bool empty() const noexcept { return list_.empty(); }
+
+        iterator begin() const noexcept { return list_.begin(); }
+        iterator end() const noexcept { return list_.end(); }
+
+        const BloomFilter<T, H>& filter() const noexcept { return filter_; }
+
+        void push_front(ListNode<T>* node);
+        void push_back(ListNode<T>* node);
+
+        // Appends the nodes of src, adding their keys to the filter. As with
+        // List<T>, this does not copy, so src is afterwards a suffix.
+        void concat(const List<T>& src);
+
+        // Merges the nodes of other, which must be sorted by f, as this list
+        // must be, adding their keys to the filter.
+        template<typename F>
+        void merge(const List<T>& other, F f);
+
+        void merge(const List<T>& other) { merge(other, std::less{}); }
+
+        // Splits the nodes, as split on a List<T> does, into two lists each
+        // with its own filter, filled as the nodes are distributed. This list
+        // hands off all its nodes and is left empty, with a cleared filter.
+        template<typename F>
+        std::pair<BloomList, BloomList> split(F f);
+
+        // Finds the first node with the key. If the filter rules the key out,
+        // this returns end() without reading any node.
+        iterator find(const T& key) const;
+
+        ListNode<T>* find_node(const T& key) const
+        {
+            return detail::node<T>(find(key));
+        }
+
+        bool contains(const T& key) const { return find(key) != end(); }
+
+        // Finds the tail and size again and refills the filter, sized for the
+        // list's current length (but at least the given count).
+        void rebuild(std::size_t expected_count = 0u);
+
+    private:
+        void grow();
+
+        List<T> list_ {};
+        BloomFilter<T, H> filter_;
+        std::size_t capacity_ {list_.size()};
+    };
+
+    template<typename T, typename H>
+    template<typename I, typename>
+    BloomList<T, H>::BloomList(Pool<ListNode<T>>& pool, const I first,
+                               const I last, const double false_positive_rate,
+                               const H hash)
+        : BloomList{List<T>{pool, first, last}, false_positive_rate, hash} { }
+
+    template<typename T, typename H>
+    void BloomList<T, H>::push_front(ListNode<T>* const node)
+    {
+        list_.push_front(node);
+        filter_.insert(node->key);
+        grow();
+    }
+
+    template<typename T, typename H>
+    void BloomList<T, H>::push_back(ListNode<T>* const node)
+    {
+        list_.push_back(node);
+        filter_.insert(node->key);
+        grow();
+    }
+
+    template<typename T, typename H>
+    void BloomList<T, H>::concat(const List<T>& src)
+    {
+        for (const auto& key : src) filter_.insert(key);
+        ek::concat(list_, src);
+        grow();
+    }
+
+    template<typename T, typename H>
+    template<typename F>
+    void BloomList<T, H>::merge(const List<T>& other, F f)
+    {
+        for (const auto& key : other) filter_.insert(key);
+        list_ = ek::merge(list_, other, f);
+        grow();
+    }
+
+    template<typename T, typename H>
+    template<typename F>
+    std::pair<BloomList<T, H>, BloomList<T, H>> BloomList<T, H>::split(F f)
+    {
+        const auto rate = filter_.false_positive_rate();
+        std::pair<BloomList, BloomList> ret {
+                BloomList{rate, filter_.hash_function()},
+                BloomList{rate, filter_.hash_function()}};
+
+        for (auto head = list_.head(); head; ) {
+            const auto next = head->next;
+            (f(head->key) ? ret.first : ret.second).push_back(head);
+            head = next;
+        }
+
+        list_ = List<T>{};
+        capacity_ = 0u;
+        filter_.resize(0u);
+        return ret;
+    }
+
+    template<typename T, typename H>
+    typename BloomList<T, H>::iterator BloomList<T, H>::find(const T& key) const
+    {
+        if (!filter_.may_contain(key)) return end();
+        return std::find(begin(), end(), key);
+    }
+
+    template<typename T, typename H>
+    void BloomList<T, H>::rebuild(const std::size_t expected_count)
+    {
+        list_ = List<T>{list_.head()};
+        capacity_ = std::max(list_.size(), expected_count);
+        filter_.resize(capacity_);
+
+        for (const auto& key : list_) filter_.insert(key);
+    }
+
+    template<typename T, typename H>
+    void BloomList<T, H>::grow()
+    {
+        if (list_.size() > capacity_)
+            rebuild(std::max(capacity_ * 2u, std::size_t{16u}));
+    }
+
+    template<typename T, typename H>
+    inline typename BloomList<T, H>::iterator
+    begin(const BloomList<T, H>& list) noexcept
+    {
+        return list.begin();
+    }
+
+    template<typename T, typename H>
+    inline typename BloomList<T, H>::iterator
+    end(const BloomList<T, H>& list) noexcept
+    {
+        return list.end();
+    }
+}
+
+#endif // ! HAVE_POOL_BLOOMFILTER_HPP_
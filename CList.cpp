@@ -0,0 +1,4 @@
+// Intrusive list algorithms applied in place to C struct list_node lists.
+// SPDX-License-Identifier: 0BSD
+
+#include "CList.hpp"
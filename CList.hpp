@@ -0,0 +1,125 @@
+// The intrusive list algorithms, applied in place to the C struct list_node
+// lists of list_node.h, such as those made by list_create.
+//
+// Copyright (c) 2018 Eliah Kagan
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+// SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+// OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+// CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef HAVE_POOL_CLIST_HPP_
+#define HAVE_POOL_CLIST_HPP_
+
+#include <functional>
+#include <utility>
+#include <vector>
+#include "CompressedList.hpp"
+#include "Intrusive.hpp"
+#include "list_node.h"
+
+// A struct list_node holds the same data as an ek::ListNode<int>, but with
+// its members in the other order, so one can't stand in for the other.
+// Instead, these functions run the algorithms in Intrusive.hpp directly on
+// the C nodes, through a hook accessor for their next member. As with the
+// ListNode<T> algorithms, predicates and comparators take keys, not nodes.
+// Nothing here allocates or frees nodes: lists from list_create still go to
+// list_destroy when done.
+namespace ek::clist {
+    using Hook = intrusive::PointerHook<list_node, &list_node::next>;
+
+    namespace detail {
+        template<typename F>
+        constexpr auto on_keys(const F f) noexcept
+        {
+            return [f](const list_node& lhs, const list_node& rhs) {
+                return f(lhs.key, rhs.key);
+            };
+        }
+    }
+
+    inline intrusive::Iterator<list_node*, Hook>
+    begin(list_node* const head) noexcept
+    {
+        return intrusive::begin<Hook>(head);
+    }
+
+    inline intrusive::Iterator<list_node*, Hook> end(list_node*) noexcept
+    {
+        return intrusive::end<Hook>(static_cast<list_node*>(nullptr));
+    }
+
+    inline bool has_cycle(const list_node* const head) noexcept
+    {
+        return intrusive::has_cycle<Hook>(head);
+    }
+
+    template<typename F>
+    list_node* find_if(list_node* const head, const F f)
+    {
+        return intrusive::find_if<Hook>(head, [f](const list_node& node) {
+            return f(node.key);
+        });
+    }
+
+    inline list_node* reverse(list_node* const head) noexcept
+    {
+        return intrusive::reverse<Hook>(head);
+    }
+
+    template<typename F>
+    std::pair<list_node*, list_node*> split(list_node* const head, const F f)
+    {
+        return intrusive::split<Hook>(head, [f](const list_node& node) {
+            return f(node.key);
+        });
+    }
+
+    template<typename F>
+    list_node* merge(list_node* const head1, list_node* const head2,
+                     const F f)
+    {
+        return intrusive::merge<Hook>(head1, head2, detail::on_keys(f));
+    }
+
+    inline list_node* merge(list_node* const head1,
+                            list_node* const head2) noexcept
+    {
+        return merge(head1, head2, std::less<int>{});
+    }
+
+    template<typename F>
+    list_node* sort(list_node* const head, const F f)
+    {
+        return intrusive::sort<Hook>(head, detail::on_keys(f));
+    }
+
+    inline list_node* sort(list_node* const head) noexcept
+    {
+        return sort(head, std::less<int>{});
+    }
+
+    inline std::vector<int> vec(const list_node* head)
+    {
+        std::vector<int> ret;
+        for (; head; head = head->next) ret.push_back(head->key);
+        return ret;
+    }
+
+    inline CompressedList<int> compress(const list_node* const head)
+    {
+        return CompressedList<int>{intrusive::begin<Hook>(head),
+                                   intrusive::end<Hook>(head),
+                                   [](const list_node& node) {
+            return node.key;
+        }};
+    }
+}
+
+#endif // ! HAVE_POOL_CLIST_HPP_
@@ -0,0 +1,4 @@
+// An index of every k-th node of a ListNode list.
+// SPDX-License-Identifier: 0BSD
+
+#include "ChunkIndex.hpp"
@@ -0,0 +1,266 @@
+// An index of every k-th node of a ListNode list, for O(sqrt n) random access
+// and for splitting the list among threads without walking it first.
+//
+// Copyright (c) 2018 Eliah Kagan
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+// SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+// OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+// CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef HAVE_POOL_CHUNKINDEX_HPP_
+#define HAVE_POOL_CHUNKINDEX_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "List.hpp"
+#include "ListNode.hpp"
+#include "Parallel.hpp"
+
+namespace ek {
+    // Splits a list into chunks of stride() consecutive nodes (the last may
+    // be shorter) and records the first node of each. The stride is about
+    // the square root of the list's length, so that both the number of
+    // chunks and the walk within a chunk are O(sqrt n). Like a List<T>, this
+    // doesn't own the nodes, and relinking them makes the index stale.
+    template<typename T>
+    class ChunkIndex {
+    public:
+        // Builds the index in one pass, doubling the stride (and dropping
+        // every other recorded node) whenever there are too many chunks.
+        explicit ChunkIndex(ListNode<T>* head);
+
+        // The length is known, so the stride is chosen up front.
+        explicit ChunkIndex(const List<T>& list);
+
+        std::size_t size() const noexcept { return size_; }
+        std::size_t stride() const noexcept { return stride_; }
+        std::size_t chunk_count() const noexcept { return heads_.size(); }
+
+        ListNode<T>* chunk(const std::size_t index) const noexcept
+        {
+            return heads_[index];
+        }
+
+        // The node at a position less than size(), in O(stride()) time.
+        ListNode<T>* node(std::size_t pos) const noexcept;
+
+        T& operator[](const std::size_t pos) const noexcept
+        {
+            return node(pos)->key;
+        }
+
+        T& at(std::size_t pos) const;
+
+        // Splits the chunks into at most the given number of contiguous
+        // parts, and calls f(first chunk, first node, node count) for each
+        // in parallel. Using 0 threads means using as many as the hardware
+        // supports, as with the algorithms in Parallel.hpp.
+        template<typename F>
+        void for_each_part(unsigned threads, F f) const;
+
+    private:
+        std::vector<ListNode<T>*> heads_;
+        std::size_t size_ {};
+        std::size_t stride_ {1u};
+    };
+
+    template<typename T>
+    ChunkIndex<T>::ChunkIndex(ListNode<T>* head)
+    {
+        for (; head; head = head->next, ++size_) {
+            if (size_ % stride_ != 0u) continue;
+
+            heads_.push_back(head);
+
+            if (heads_.size() > stride_ * 2u) {
+                auto kept = std::size_t{0u};
+                for (auto i = std::size_t{0u}; i < heads_.size(); i += 2u)
+                    heads_[kept++] = heads_[i];
+
+                heads_.resize(kept);
+                stride_ *= 2u;
+            }
+        }
+    }
+
+    template<typename T>
+    ChunkIndex<T>::ChunkIndex(const List<T>& list)
+        : size_{list.size()},
+          stride_{std::max(std::size_t{1u}, static_cast<std::size_t>(
+                std::ceil(std::sqrt(static_cast<double>(list.size())))))}
+    {
+        heads_.reserve((size_ + stride_ - 1u) / stride_);
+
+        auto pos = std::size_t{0u};
+        for (auto node = list.head(); node; node = node->next, ++pos)
+            if (pos % stride_ == 0u) heads_.push_back(node);
+    }
+
+    template<typename T>
+    ListNode<T>* ChunkIndex<T>::node(const std::size_t pos) const noexcept
+    {
+        auto ret = heads_[pos / stride_];
+        for (auto i = pos % stride_; i != 0u; --i) ret = ret->next;
+        return ret;
+    }
+
+    template<typename T>
+    T& ChunkIndex<T>::at(const std::size_t pos) const
+    {
+        if (pos >= size_)
+            throw std::out_of_range{"position is past the end of the list"};
+
+        return node(pos)->key;
+    }
+
+    template<typename T>
+    template<typename F>
+    void ChunkIndex<T>::for_each_part(const unsigned threads, F f) const
+    {
+        detail::parallel_for(heads_.size(), detail::thread_count(threads),
+                             [&](const std::size_t first,
+                                 const std::size_t last) {
+            if (first == last) return;
+
+            f(first, heads_[first],
+              std::min(size_, last * stride_) - first * stride_);
+        });
+    }
+
+    template<typename T, typename F>
+    void parallel_for_each(const ChunkIndex<T>& index, F f,
+                           const unsigned threads = 0u)
+    {
+        index.for_each_part(threads, [&f](std::size_t, ListNode<T>* node,
+                                          std::size_t count) {
+            for (; count != 0u; --count, node = node->next) f(node->key);
+        });
+    }
+
+    // Each thread folds its part, starting from the part's first key, and
+    // then the parts' results are folded into init in order. So f must be
+    // associative, but need not be commutative.
+    template<typename T, typename F>
+    T parallel_fold(const ChunkIndex<T>& index, T init, F f,
+                    const unsigned threads = 0u)
+    {
+        std::vector<std::optional<T>> folds (index.chunk_count());
+
+        index.for_each_part(threads, [&](const std::size_t chunk,
+                                         const ListNode<T>* node,
+                                         std::size_t count) {
+            T acc = node->key;
+            while (--count != 0u) {
+                node = node->next;
+                acc = f(std::move(acc), node->key);
+            }
+
+            folds[chunk] = std::move(acc);
+        });
+
+        for (auto& fold : folds)
+            if (fold) init = f(std::move(init), std::move(*fold));
+
+        return init;
+    }
+
+    // Finds the first node satisfying f. A thread stops once another has
+    // found a match in an earlier chunk than the one it would search next.
+    template<typename T, typename F>
+    typename ListNode<T>::iterator
+    parallel_find_if(const ChunkIndex<T>& index, F f,
+                     const unsigned threads = 0u)
+    {
+        constexpr auto none = std::numeric_limits<std::size_t>::max();
+
+        std::vector<ListNode<T>*> found (index.chunk_count());
+        std::atomic<std::size_t> bound {none};
+
+        index.for_each_part(threads, [&](const std::size_t first,
+                                         ListNode<T>* node,
+                                         std::size_t count) {
+            for (auto chunk = first; count != 0u; ++chunk) {
+                if (chunk > bound.load(std::memory_order_relaxed)) return;
+
+                for (auto i = std::min(count, index.stride()); i != 0u;
+                        --i, --count, node = node->next) {
+                    if (!f(node->key)) continue;
+
+                    found[first] = node;
+
+                    auto old = bound.load(std::memory_order_relaxed);
+                    while (chunk < old && !bound.compare_exchange_weak(
+                                    old, chunk, std::memory_order_relaxed)) { }
+                    return;
+                }
+            }
+        });
+
+        const auto pos = std::find_if(cbegin(found), cend(found),
+                                      [](const ListNode<T>* const node) {
+            return node != nullptr;
+        });
+
+        return typename ListNode<T>::iterator{pos == cend(found) ? nullptr
+                                                                 : *pos};
+    }
+
+    // Each thread compares a part of the first list with the nodes at the
+    // same positions in the second, which it finds through that index.
+    template<typename T, typename U, typename F>
+    bool parallel_equal(const ChunkIndex<T>& index1,
+                        const ChunkIndex<U>& index2, F f,
+                        const unsigned threads = 0u)
+    {
+        if (index1.size() != index2.size()) return false;
+
+        std::atomic<bool> differ {false};
+
+        index1.for_each_part(threads, [&](const std::size_t first,
+                                          const ListNode<T>* node1,
+                                          std::size_t count) {
+            const ListNode<U>* node2 = index2.node(first * index1.stride());
+
+            for (auto i = std::size_t{0u}; count != 0u; --count, ++i) {
+                if (i % index1.stride() == 0u
+                        && differ.load(std::memory_order_relaxed))
+                    return;
+
+                if (!f(node1->key, node2->key)) {
+                    differ.store(true, std::memory_order_relaxed);
+                    return;
+                }
+
+                node1 = node1->next;
+                node2 = node2->next;
+            }
+        });
+
+        return !differ.load();
+    }
+
+    template<typename T, typename U>
+    inline bool parallel_equal(const ChunkIndex<T>& index1,
+                               const ChunkIndex<U>& index2,
+                               const unsigned threads = 0u)
+    {
+        return parallel_equal(index1, index2, std::equal_to<>{}, threads);
+    }
+}
+
+#endif // ! HAVE_POOL_CHUNKINDEX_HPP_
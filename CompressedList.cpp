@@ -0,0 +1,4 @@
+// An immutable compressed sequence of integers.
+// SPDX-License-Identifier: 0BSD
+
+#include "CompressedList.hpp"
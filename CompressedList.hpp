@@ -0,0 +1,631 @@
+// An immutable compressed sequence of integers, built from a list or range,
+// with folds and searches that work on the compressed blocks.
+//
+// Copyright (c) 2018 Eliah Kagan
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+// SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+// OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+// CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef HAVE_POOL_COMPRESSEDLIST_HPP_
+#define HAVE_POOL_COMPRESSEDLIST_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "List.hpp"
+#include "ListNode.hpp"
+
+namespace ek {
+    namespace detail {
+        // Keys are encoded as 64-bit unsigned values, and arithmetic on them
+        // wraps, which round-trips every integer type of up to 64 bits.
+        template<typename T>
+        constexpr std::uint64_t widen(const T key) noexcept
+        {
+            return static_cast<std::uint64_t>(key);
+        }
+
+        // Maps small differences of either sign to small unsigned values.
+        constexpr std::uint64_t zigzag(const std::uint64_t delta) noexcept
+        {
+            return delta << 1u ^ (0u - (delta >> 63u));
+        }
+
+        constexpr std::uint64_t unzigzag(const std::uint64_t code) noexcept
+        {
+            return code >> 1u ^ (0u - (code & 1u));
+        }
+
+        constexpr unsigned bit_width(std::uint64_t x) noexcept
+        {
+            auto ret = 0u;
+            for (; x != 0u; x >>= 1u) ++ret;
+            return ret;
+        }
+
+        // LEB128: seven bits per byte, low bits first, high bit set on all
+        // but the last byte.
+        constexpr std::size_t varint_size(std::uint64_t x) noexcept
+        {
+            auto ret = std::size_t{1u};
+            for (; x >= 0x80u; x >>= 7u) ++ret;
+            return ret;
+        }
+
+        inline void put_varint(std::vector<unsigned char>& out,
+                               std::uint64_t x)
+        {
+            for (; x >= 0x80u; x >>= 7u)
+                out.push_back(static_cast<unsigned char>(x | 0x80u));
+            out.push_back(static_cast<unsigned char>(x));
+        }
+
+        inline std::uint64_t get_varint(const unsigned char*& p) noexcept
+        {
+            auto ret = std::uint64_t{0u};
+
+            for (auto shift = 0u; ; shift += 7u) {
+                const auto byte = *p++;
+                ret |= std::uint64_t{byte & 0x7Fu} << shift;
+                if (byte < 0x80u) return ret;
+            }
+        }
+
+        // Compilers turn this into a single load on little-endian machines.
+        inline std::uint64_t load_le64(const unsigned char* const p) noexcept
+        {
+            return std::uint64_t{p[0]} | std::uint64_t{p[1]} << 8u
+                    | std::uint64_t{p[2]} << 16u | std::uint64_t{p[3]} << 24u
+                    | std::uint64_t{p[4]} << 32u | std::uint64_t{p[5]} << 40u
+                    | std::uint64_t{p[6]} << 48u | std::uint64_t{p[7]} << 56u;
+        }
+
+        // Bit-packed offsets come in groups of 8, each taking width bytes, so
+        // with the width known at compile time each offset in a group is at a
+        // constant byte and shift, and compilers can unroll and vectorize the
+        // fixed-stride loop for the target. Whole groups are read
+        // and written, so out must have room for count rounded up to 8, and
+        // there must be padding after the data.
+        template<unsigned Width>
+        void unpack_fixed(const unsigned char* data, const std::size_t count,
+                          std::uint64_t* out) noexcept
+        {
+            constexpr auto mask = (std::uint64_t{1u} << Width) - 1u;
+
+            for (auto i = std::size_t{0u}; i < count; i += 8u) {
+                for (auto j = 0u; j != 8u; ++j) {
+                    out[j] = load_le64(data + j * Width / 8u)
+                                >> (j * Width % 8u) & mask;
+                }
+
+                data += Width;
+                out += 8u;
+            }
+        }
+
+        using Unpacker = void (*)(const unsigned char*, std::size_t,
+                                  std::uint64_t*) noexcept;
+
+        template<unsigned... Widths>
+        constexpr std::array<Unpacker, sizeof...(Widths) + 1u>
+        make_unpackers(std::integer_sequence<unsigned, Widths...>) noexcept
+        {
+            return {nullptr, &unpack_fixed<Widths + 1u>...};
+        }
+
+        // Unpackers for widths 1 to 57, indexed by width. Wider offsets may
+        // not fit in the 8 bytes starting where they start.
+        inline constexpr auto unpackers =
+                make_unpackers(std::make_integer_sequence<unsigned, 57u>{});
+
+        // Enough padding for the last group of any block to be read whole.
+        inline constexpr std::size_t unpack_padding = 64u;
+    }
+
+    // Keys are stored in blocks of block_size, each encoded whichever of
+    // three ways is smallest for it: frame of reference (each key's offset
+    // from the block's minimum, bit-packed at the width of the largest
+    // offset), delta (the difference of each key from the one before, as a
+    // zigzag varint), or runs (each run of equal keys as its difference from
+    // the last run's key and its length, both varints). Blocks record their
+    // minimum and maximum, so searches skip blocks that can't match, and
+    // folds take runs whole. T must be an integer type other than bool.
+    template<typename T>
+    class CompressedList {
+    public:
+        static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>
+                        && sizeof(T) <= sizeof(std::uint64_t));
+
+        using size_type = std::size_t;
+
+        // Sums wrap modulo 2**64, so they are exact when they fit.
+        using sum_type = std::conditional_t<std::is_signed_v<T>,
+                                            long long, unsigned long long>;
+
+        enum class Encoding : unsigned char { frame, delta, runs };
+
+        static constexpr size_type block_size = 128u;
+        static constexpr auto npos = std::numeric_limits<size_type>::max();
+
+        CompressedList() noexcept = default;
+
+        // Stores key(*it) for each it in [first, last).
+        template<typename I, typename F>
+        CompressedList(I first, I last, F key);
+
+        template<typename I>
+        CompressedList(const I first, const I last)
+            : CompressedList{first, last, [](const T key) { return key; }}
+        {
+        }
+
+        explicit CompressedList(const ListNode<T>* const head)
+            : CompressedList{cbegin(head), cend(head)} { }
+
+        explicit CompressedList(const List<T>& list)
+            : CompressedList{cbegin(list), cend(list)} { }
+
+        CompressedList(const std::initializer_list<T> ilist)
+            : CompressedList{std::cbegin(ilist), std::cend(ilist)} { }
+
+        size_type size() const noexcept { return size_; }
+        bool empty() const noexcept { return size_ == 0u; }
+
+        // The memory taken by the encoded keys and the block headers.
+        std::size_t bytes() const noexcept
+        {
+            return data_.size() + blocks_.size() * sizeof(Block);
+        }
+
+        Encoding encoding(const size_type block) const noexcept
+        {
+            return blocks_[block].encoding;
+        }
+
+        size_type block_count() const noexcept { return blocks_.size(); }
+
+        // Frame of reference blocks are random access. Other blocks are
+        // decoded from their start, at most block_size steps.
+        T operator[](size_type pos) const noexcept;
+
+        T at(size_type pos) const;
+
+        sum_type sum() const noexcept;
+        T min() const;
+        T max() const;
+
+        // How many keys equal x.
+        size_type count(T x) const noexcept;
+
+        // The position of the first key equal to x, or npos if none is.
+        size_type index(T x) const noexcept;
+
+        friend std::vector<T> vec(const CompressedList& list)
+        {
+            std::vector<T> ret (list.size_);
+
+            for (auto b = size_type{0u}; b != list.blocks_.size(); ++b) {
+                list.decode(list.blocks_[b], list.block_length(b),
+                            ret.data() + b * block_size);
+            }
+
+            return ret;
+        }
+
+    private:
+        struct Block {
+            std::size_t offset; // where its bytes start in data_
+            T first;
+            T min;
+            T max;
+            Encoding encoding;
+            unsigned char width; // of each offset, for frame of reference
+        };
+
+        size_type block_length(const size_type block) const noexcept
+        {
+            return std::min(block_size, size_ - block * block_size);
+        }
+
+        void add_block(const T* keys, size_type count);
+
+        std::uint64_t bits(std::size_t pos, unsigned width) const noexcept;
+
+        // Unpacks the offsets in a frame of reference block into out, which
+        // must have room for block_size offsets.
+        void unpack(const Block& block, size_type count,
+                    std::uint64_t* out) const noexcept;
+
+        // Decodes the keys in a block of any encoding.
+        void decode(const Block& block, size_type count,
+                    T* out) const noexcept;
+
+        // Calls f(key, length) for each run in a run-length encoded block.
+        template<typename F>
+        void for_each_run(const Block& block, size_type count, F f) const;
+
+        std::vector<Block> blocks_;
+        std::vector<unsigned char> data_;
+        size_type size_ {};
+    };
+
+    template<typename T>
+    template<typename I, typename F>
+    CompressedList<T>::CompressedList(I first, const I last, F key)
+    {
+        T keys[block_size];
+        auto count = size_type{0u};
+
+        for (; first != last; ++first) {
+            keys[count++] = key(*first);
+            if (count == block_size) {
+                add_block(keys, count);
+                count = 0u;
+            }
+        }
+
+        if (count != 0u) add_block(keys, count);
+
+        // Padding, so bit-packed offsets can be read as 64-bit words.
+        data_.resize(data_.size() + detail::unpack_padding);
+        data_.shrink_to_fit();
+        blocks_.shrink_to_fit();
+    }
+
+    template<typename T>
+    T CompressedList<T>::operator[](const size_type pos) const noexcept
+    {
+        const auto& block = blocks_[pos / block_size];
+        const auto k = pos % block_size;
+
+        if (block.encoding == Encoding::frame) {
+            return static_cast<T>(detail::widen(block.min)
+                                    + bits(block.offset * 8u
+                                                + k * block.width,
+                                           block.width));
+        }
+
+        auto p = &data_[block.offset];
+        auto key = detail::widen(block.first);
+
+        if (block.encoding == Encoding::delta) {
+            for (auto i = k; i != 0u; --i)
+                key += detail::unzigzag(detail::get_varint(p));
+            return static_cast<T>(key);
+        }
+
+        for (auto skipped = size_type{0u}; ; ) {
+            key += detail::unzigzag(detail::get_varint(p));
+            skipped += detail::get_varint(p);
+            if (k < skipped) return static_cast<T>(key);
+        }
+    }
+
+    template<typename T>
+    T CompressedList<T>::at(const size_type pos) const
+    {
+        if (pos >= size_) throw std::out_of_range{"index out of range"};
+        return (*this)[pos];
+    }
+
+    template<typename T>
+    typename CompressedList<T>::sum_type CompressedList<T>::sum()
+        const noexcept
+    {
+        auto ret = std::uint64_t{0u};
+
+        for (auto b = size_type{0u}; b != blocks_.size(); ++b) {
+            const auto& block = blocks_[b];
+            const auto count = block_length(b);
+
+            switch (block.encoding) {
+            case Encoding::frame: {
+                std::uint64_t offsets[block_size];
+                unpack(block, count, offsets);
+
+                ret += count * detail::widen(block.min);
+                for (auto i = size_type{0u}; i != count; ++i)
+                    ret += offsets[i];
+                break;
+            }
+
+            case Encoding::delta: {
+                auto p = &data_[block.offset];
+                auto key = detail::widen(block.first);
+                ret += key;
+
+                for (auto i = size_type{1u}; i != count; ++i) {
+                    key += detail::unzigzag(detail::get_varint(p));
+                    ret += key;
+                }
+                break;
+            }
+
+            case Encoding::runs:
+                for_each_run(block, count, [&ret](const T key,
+                                                  const size_type length) {
+                    ret += length * detail::widen(key);
+                });
+                break;
+            }
+        }
+
+        return static_cast<sum_type>(ret);
+    }
+
+    template<typename T>
+    T CompressedList<T>::min() const
+    {
+        if (empty())
+            throw std::invalid_argument{"empty list has no minimal element"};
+
+        return std::min_element(cbegin(blocks_), cend(blocks_),
+                                [](const Block& lhs, const Block& rhs) {
+            return lhs.min < rhs.min;
+        })->min;
+    }
+
+    template<typename T>
+    T CompressedList<T>::max() const
+    {
+        if (empty())
+            throw std::invalid_argument{"empty list has no maximal element"};
+
+        return std::max_element(cbegin(blocks_), cend(blocks_),
+                                [](const Block& lhs, const Block& rhs) {
+            return lhs.max < rhs.max;
+        })->max;
+    }
+
+    template<typename T>
+    typename CompressedList<T>::size_type
+    CompressedList<T>::count(const T x) const noexcept
+    {
+        auto ret = size_type{0u};
+
+        for (auto b = size_type{0u}; b != blocks_.size(); ++b) {
+            const auto& block = blocks_[b];
+            const auto count = block_length(b);
+
+            if (x < block.min || block.max < x) continue;
+
+            if (block.min == block.max) {
+                ret += count;
+                continue;
+            }
+
+            switch (block.encoding) {
+            case Encoding::frame: {
+                std::uint64_t offsets[block_size];
+                unpack(block, count, offsets);
+
+                const auto target = detail::widen(x) - detail::widen(block.min);
+                for (auto i = size_type{0u}; i != count; ++i)
+                    ret += (offsets[i] == target);
+                break;
+            }
+
+            case Encoding::delta: {
+                T keys[block_size];
+                decode(block, count, keys);
+
+                for (auto i = size_type{0u}; i != count; ++i)
+                    ret += (keys[i] == x);
+                break;
+            }
+
+            case Encoding::runs:
+                for_each_run(block, count, [x, &ret](const T key,
+                                                     const size_type length) {
+                    if (key == x) ret += length;
+                });
+                break;
+            }
+        }
+
+        return ret;
+    }
+
+    template<typename T>
+    typename CompressedList<T>::size_type
+    CompressedList<T>::index(const T x) const noexcept
+    {
+        for (auto b = size_type{0u}; b != blocks_.size(); ++b) {
+            const auto& block = blocks_[b];
+            if (x < block.min || block.max < x) continue;
+
+            // A block whose range includes x may still not contain it.
+            T keys[block_size];
+            const auto count = block_length(b);
+            decode(block, count, keys);
+
+            const auto pos = std::find(keys, keys + count, x) - keys;
+            if (static_cast<size_type>(pos) != count)
+                return b * block_size + static_cast<size_type>(pos);
+        }
+
+        return npos;
+    }
+
+    template<typename T>
+    void CompressedList<T>::add_block(const T* const keys,
+                                      const size_type count)
+    {
+        using detail::widen, detail::zigzag, detail::varint_size;
+
+        const auto [low, high] = std::minmax_element(keys, keys + count);
+        const auto width = detail::bit_width(widen(*high) - widen(*low));
+
+        // Calls f(first, last) for each run [first, last) of equal keys.
+        const auto for_each_run_of = [keys, count](const auto f) {
+            for (auto i = size_type{0u}; i != count; ) {
+                auto j = i + 1u;
+                while (j != count && keys[j] == keys[i]) ++j;
+                f(i, j);
+                i = j;
+            }
+        };
+
+        auto delta_bytes = std::size_t{0u}, run_bytes = std::size_t{0u};
+
+        for (auto i = size_type{1u}; i != count; ++i) {
+            delta_bytes += varint_size(zigzag(widen(keys[i])
+                                                - widen(keys[i - 1u])));
+        }
+
+        // Each run's key is relative to the last run's, the first's to itself.
+        auto prev = keys[0];
+        for_each_run_of([&](const size_type first, const size_type last) {
+            run_bytes += varint_size(zigzag(widen(keys[first]) - widen(prev)))
+                            + varint_size(last - first);
+            prev = keys[first];
+        });
+
+        const auto frame_bytes = (count * width + 7u) / 8u;
+
+        Block block {data_.size(), keys[0], *low, *high, Encoding::frame,
+                     static_cast<unsigned char>(width)};
+
+        if (frame_bytes <= delta_bytes && frame_bytes <= run_bytes) {
+            data_.resize(data_.size() + frame_bytes);
+            const auto out = &data_[block.offset];
+
+            for (auto i = size_type{0u}; i != count; ++i) {
+                const auto offset = widen(keys[i]) - widen(*low);
+                for (auto done = 0u; done < width; ) {
+                    const auto pos = i * width + done;
+                    const auto shift = static_cast<unsigned>(pos % 8u);
+                    const auto take = std::min(8u - shift, width - done);
+                    const auto piece = offset >> done
+                                        & ((std::uint64_t{1u} << take) - 1u);
+                    out[pos / 8u] |= static_cast<unsigned char>(piece << shift);
+                    done += take;
+                }
+            }
+        } else if (run_bytes < delta_bytes) {
+            block.encoding = Encoding::runs;
+
+            prev = keys[0];
+            for_each_run_of([&](const size_type first, const size_type last) {
+                detail::put_varint(data_,
+                                   zigzag(widen(keys[first]) - widen(prev)));
+                detail::put_varint(data_, last - first);
+                prev = keys[first];
+            });
+        } else {
+            block.encoding = Encoding::delta;
+
+            for (auto i = size_type{1u}; i != count; ++i) {
+                detail::put_varint(data_, zigzag(widen(keys[i])
+                                                    - widen(keys[i - 1u])));
+            }
+        }
+
+        blocks_.push_back(block);
+        size_ += count;
+    }
+
+    template<typename T>
+    std::uint64_t CompressedList<T>::bits(const std::size_t pos,
+                                          const unsigned width) const noexcept
+    {
+        if (width == 0u) return 0u;
+
+        const auto p = &data_[pos / 8u];
+        const auto shift = static_cast<unsigned>(pos % 8u);
+
+        auto ret = detail::load_le64(p) >> shift;
+        if (shift + width > 64u) ret |= std::uint64_t{p[8]} << (64u - shift);
+
+        return width == 64u ? ret : ret & ((std::uint64_t{1u} << width) - 1u);
+    }
+
+    template<typename T>
+    void CompressedList<T>::unpack(const Block& block, const size_type count,
+                                   std::uint64_t* const out) const noexcept
+    {
+        const unsigned width = block.width;
+
+        if (width == 0u) {
+            std::fill_n(out, count, std::uint64_t{0u});
+        } else if (width < detail::unpackers.size()) {
+            detail::unpackers[width](&data_[block.offset], count, out);
+        } else {
+            const auto base = block.offset * 8u;
+            for (auto i = size_type{0u}; i != count; ++i)
+                out[i] = bits(base + i * width, width);
+        }
+    }
+
+    template<typename T>
+    void CompressedList<T>::decode(const Block& block, const size_type count,
+                                   T* const out) const noexcept
+    {
+        switch (block.encoding) {
+        case Encoding::frame: {
+            std::uint64_t offsets[block_size];
+            unpack(block, count, offsets);
+
+            const auto low = detail::widen(block.min);
+            for (auto i = size_type{0u}; i != count; ++i)
+                out[i] = static_cast<T>(low + offsets[i]);
+            break;
+        }
+
+        case Encoding::delta: {
+            auto p = &data_[block.offset];
+            auto key = detail::widen(block.first);
+            out[0] = block.first;
+
+            for (auto i = size_type{1u}; i != count; ++i) {
+                key += detail::unzigzag(detail::get_varint(p));
+                out[i] = static_cast<T>(key);
+            }
+            break;
+        }
+
+        case Encoding::runs: {
+            auto pos = size_type{0u};
+            for_each_run(block, count, [out, &pos](const T key,
+                                                   const size_type length) {
+                std::fill_n(out + pos, length, key);
+                pos += length;
+            });
+            break;
+        }
+        }
+    }
+
+    template<typename T>
+    template<typename F>
+    void CompressedList<T>::for_each_run(const Block& block,
+                                         const size_type count, F f) const
+    {
+        auto p = &data_[block.offset];
+        auto key = detail::widen(block.first);
+
+        for (auto done = size_type{0u}; done != count; ) {
+            key += detail::unzigzag(detail::get_varint(p));
+            const auto length = detail::get_varint(p);
+            f(static_cast<T>(key), length);
+            done += length;
+        }
+    }
+}
+
+#endif // ! HAVE_POOL_COMPRESSEDLIST_HPP_
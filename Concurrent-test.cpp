@@ -0,0 +1,230 @@
+// Implementation of tests of ConcurrentStack, ConcurrentQueue, and
+// ConcurrentSkipList.
+//
+// Copyright (c) 2018 Eliah Kagan
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+// SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+// OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+// CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include "Concurrent-test.hpp"
+
+#include "Concurrent.hpp"
+#include "ConcurrentSkipList.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    using namespace std::literals;
+    using ek::ConcurrentQueue, ek::ConcurrentSkipList, ek::ConcurrentStack;
+
+    void test_stack_sequential()
+    {
+        ConcurrentStack<std::string> stack {3u};
+
+        assert(stack.push("foo"s) && stack.push("bar"s) && stack.push("baz"s));
+        assert(!stack.push("quux"s));
+
+        for (auto s = stack.pop(); s; s = stack.pop()) std::cout << *s << ' ';
+        std::cout << '\n';
+
+        assert(stack.push("foobar"s) && *stack.pop() == "foobar");
+        assert(!stack.pop());
+    }
+
+    void test_queue_sequential()
+    {
+        ConcurrentQueue<std::string> queue {3u};
+
+        assert(!queue.pop());
+        assert(queue.push("foo"s) && queue.push("bar"s) && queue.push("baz"s));
+        assert(!queue.push("quux"s));
+
+        for (auto s = queue.pop(); s; s = queue.pop()) std::cout << *s << ' ';
+        std::cout << '\n';
+
+        for (auto i = 0; i != 10; ++i) {
+            assert(queue.push(std::to_string(i)));
+            assert(queue.push(std::to_string(i + 100)));
+            assert(*queue.pop() == std::to_string(i));
+            assert(*queue.pop() == std::to_string(i + 100));
+        }
+
+        assert(!queue.pop());
+    }
+
+    // Producers push distinct values while consumers pop them. Every value
+    // must come out exactly once, and (for a queue) each producer's values
+    // must come out in the order that producer pushed them.
+    template<typename C>
+    void stress(const char* const name, const bool fifo)
+    {
+        constexpr auto producers = 4, consumers = 4, per_producer = 20'000;
+        constexpr auto total = producers * per_producer;
+
+        C container {1'000u};
+        std::vector<std::atomic<int>> seen (total);
+        std::atomic<int> popped {0};
+        std::atomic<bool> in_order {true};
+
+        std::vector<std::thread> threads;
+
+        for (auto p = 0; p != producers; ++p) {
+            threads.emplace_back([&container, p] {
+                for (auto i = 0; i != per_producer; ) {
+                    if (container.push(p * per_producer + i)) ++i;
+                    else std::this_thread::yield();
+                }
+            });
+        }
+
+        for (auto c = 0; c != consumers; ++c) {
+            threads.emplace_back([&] {
+                std::vector<int> last (producers, -1);
+
+                while (popped.load() != total) {
+                    const auto x = container.pop();
+                    if (!x) {
+                        std::this_thread::yield();
+                        continue;
+                    }
+
+                    ++seen[static_cast<std::size_t>(*x)];
+                    ++popped;
+
+                    auto& prev = last[static_cast<std::size_t>(
+                            *x / per_producer)];
+                    if (*x < prev) in_order = false;
+                    prev = *x;
+                }
+            });
+        }
+
+        for (auto& thread : threads) thread.join();
+
+        for (const auto& count : seen) assert(count.load() == 1);
+        assert(!fifo || in_order.load());
+        assert(!container.pop());
+
+        std::cout << name << ": " << popped.load() << " values passed through "
+                  << producers << " producers and " << consumers
+                  << " consumers\n";
+    }
+    void test_skip_list_sequential()
+    {
+        // At most 100 keys, and up to 9 erased towers awaiting reclaim.
+        ConcurrentSkipList<int> skip {109u};
+        std::set<int> expected;
+        std::mt19937 gen {42u};
+        std::uniform_int_distribution<int> pick {0, 199};
+
+        for (auto i = 0; i != 2'000; ++i) {
+            const auto key = pick(gen);
+
+            if (expected.size() == 100u || gen() % 2u != 0u)
+                assert(skip.erase(key) == (expected.erase(key) != 0u));
+            else
+                assert(skip.insert(key) == expected.insert(key).second);
+
+            assert(skip.contains(key) == (expected.count(key) != 0u));
+            assert(skip.size() == expected.size());
+
+            if (i % 10 == 9) skip.reclaim();
+        }
+
+        assert(std::equal(begin(skip), end(skip),
+                          cbegin(expected), cend(expected)));
+
+        const auto in_range = ek::collect(skip.range(50, 60));
+        assert(std::equal(cbegin(in_range), cend(in_range),
+                          expected.lower_bound(50), expected.lower_bound(60)));
+
+        for (const auto x : in_range) std::cout << x << ' ';
+        std::cout << '\n';
+
+        ConcurrentSkipList<int, std::greater<int>> full {2u};
+        assert(full.insert(1) && full.insert(2) && !full.insert(2));
+        assert(*full.begin() == 2 && *full.lower_bound(1) == 1);
+
+        auto threw = false;
+        try {
+            full.insert(3);
+        } catch (const std::length_error&) {
+            threw = true;
+        }
+        assert(threw);
+
+        assert(full.erase(2) && !full.erase(2));
+        full.reclaim();
+        assert(full.insert(3) && full.size() == 2u);
+    }
+
+    // Each thread inserts and erases keys of its own residue class, and also
+    // looks up every key. Afterwards the skip list must hold exactly the keys
+    // the threads last left in it, in order.
+    void test_skip_list_stress()
+    {
+        constexpr auto thread_count = 4, keys = 4'000, rounds = 5;
+
+        ConcurrentSkipList<int> skip {static_cast<std::size_t>(keys * rounds)};
+        std::vector<std::thread> threads;
+
+        for (auto t = 0; t != thread_count; ++t) {
+            threads.emplace_back([&skip, t] {
+                for (auto round = 0; round != rounds; ++round) {
+                    for (auto key = t; key < keys; key += thread_count) {
+                        assert(skip.insert(key));
+                        static_cast<void>(skip.contains(key ^ 1));
+                    }
+
+                    for (auto key = t; key < keys; key += thread_count) {
+                        if (round == rounds - 1 && key % 3 != 0) continue;
+                        assert(skip.erase(key));
+                    }
+                }
+            });
+        }
+
+        for (auto& thread : threads) thread.join();
+        skip.reclaim();
+
+        std::vector<int> expected;
+        for (auto key = 0; key != keys; ++key)
+            if (key % 3 != 0) expected.push_back(key);
+
+        assert(skip.size() == expected.size());
+        assert(std::equal(begin(skip), end(skip),
+                          cbegin(expected), cend(expected)));
+
+        std::cout << "skip list: " << skip.size() << " keys left by "
+                  << thread_count << " threads\n";
+    }
+}
+
+void run_concurrent_tests()
+{
+    test_stack_sequential();
+    test_queue_sequential();
+    stress<ConcurrentStack<int>>("stack", false);
+    stress<ConcurrentQueue<int>>("queue", true);
+    test_skip_list_sequential();
+    test_skip_list_stress();
+}
@@ -0,0 +1,4 @@
+// Lock-free stack and queue of ListNode objects from a Pool.
+// SPDX-License-Identifier: 0BSD
+
+#include "Concurrent.hpp"
@@ -0,0 +1,331 @@
+// Lock-free stack (Treiber) and queue (Michael-Scott) of ListNode objects
+// from a Pool, with nodes recycled through a lock-free free list.
+//
+// Copyright (c) 2018 Eliah Kagan
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+// SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+// OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+// CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef HAVE_POOL_CONCURRENT_HPP_
+#define HAVE_POOL_CONCURRENT_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "ListNode.hpp"
+#include "Pool.hpp"
+
+namespace ek {
+    namespace detail {
+        // A link is a 32-bit node index and a 32-bit tag. Every successful
+        // compare-exchange of a link bumps its tag, so a thread holding a
+        // stale copy of a link whose index has since been popped and pushed
+        // back (the ABA problem) fails its compare-exchange and retries.
+        using Link = std::uint64_t;
+
+        inline constexpr auto nil = std::numeric_limits<std::uint32_t>::max();
+
+        constexpr Link make_link(const std::uint32_t index,
+                                 const std::uint32_t tag) noexcept
+        {
+            return Link{tag} << 32u | index;
+        }
+
+        constexpr std::uint32_t index_of(const Link link) noexcept
+        {
+            return static_cast<std::uint32_t>(link);
+        }
+
+        constexpr std::uint32_t tag_of(const Link link) noexcept
+        {
+            return static_cast<std::uint32_t>(link >> 32u);
+        }
+
+        constexpr Link relink(const Link old, const std::uint32_t index)
+            noexcept
+        {
+            return make_link(index, tag_of(old) + 1u);
+        }
+
+        // A fixed number of ListNode<T> objects, allocated up front from a
+        // Pool so their addresses never change, with a lock-free free list.
+        // ListNode<T>::next isn't atomic, so links between nodes are kept in
+        // a parallel array of atomic tagged indices, and next is unused.
+        template<typename T>
+        class NodeArena {
+        public:
+            explicit NodeArena(std::size_t count);
+
+            ListNode<T>& node(const std::uint32_t index) noexcept
+            {
+                return *nodes_[index];
+            }
+
+            std::atomic<Link>& link(const std::uint32_t index) noexcept
+            {
+                return links_[index];
+            }
+
+            // Takes a node from the free list. Returns nil if there is none.
+            std::uint32_t acquire() noexcept;
+
+            // Returns a node that no other thread will access to the free list.
+            void release(std::uint32_t index) noexcept;
+
+        private:
+            Pool<ListNode<T>> pool_;
+            std::vector<ListNode<T>*> nodes_;
+            std::unique_ptr<std::atomic<Link>[]> links_;
+            std::atomic<Link> free_;
+        };
+
+        template<typename T>
+        NodeArena<T>::NodeArena(const std::size_t count)
+            : links_{new std::atomic<Link>[count]}, free_{make_link(nil, 0u)}
+        {
+            if (count >= nil)
+                throw std::length_error{"too many nodes for 32-bit indices"};
+
+            nodes_.reserve(count);
+            for (auto i = count; i != 0u; --i) nodes_.push_back(pool_());
+
+            for (auto i = static_cast<std::uint32_t>(count); i-- != 0u; ) {
+                links_[i].store(make_link(nil, 0u), std::memory_order_relaxed);
+                release(i);
+            }
+        }
+
+        template<typename T>
+        std::uint32_t NodeArena<T>::acquire() noexcept
+        {
+            auto top = free_.load(std::memory_order_acquire);
+
+            for (; ; ) {
+                const auto index = index_of(top);
+                if (index == nil) return nil;
+
+                const auto next = links_[index].load(std::memory_order_relaxed);
+
+                if (free_.compare_exchange_weak(top,
+                                                relink(top, index_of(next)),
+                                                std::memory_order_acquire,
+                                                std::memory_order_acquire))
+                    return index;
+            }
+        }
+
+        template<typename T>
+        void NodeArena<T>::release(const std::uint32_t index) noexcept
+        {
+            auto& link = links_[index];
+            auto top = free_.load(std::memory_order_relaxed);
+
+            // Bump the node's own tag too, in case a queue operation has a
+            // stale copy of the link from when the node was in the queue.
+            do {
+                link.store(relink(link.load(std::memory_order_relaxed),
+                                  index_of(top)),
+                           std::memory_order_relaxed);
+            } while (!free_.compare_exchange_weak(top, relink(top, index),
+                                                  std::memory_order_release,
+                                                  std::memory_order_relaxed));
+        }
+    }
+
+    // A bounded lock-free LIFO stack. T must be default constructible (for
+    // the preallocated nodes) and move assignable.
+    template<typename T>
+    class ConcurrentStack {
+    public:
+        explicit ConcurrentStack(const std::size_t capacity)
+            : arena_{capacity} { }
+
+        // Returns false, without pushing, if the stack is full.
+        bool push(T value);
+
+        std::optional<T> pop();
+
+    private:
+        detail::NodeArena<T> arena_;
+        std::atomic<detail::Link> head_ {detail::make_link(detail::nil, 0u)};
+    };
+
+    template<typename T>
+    bool ConcurrentStack<T>::push(T value)
+    {
+        const auto index = arena_.acquire();
+        if (index == detail::nil) return false;
+
+        arena_.node(index).key = std::move(value);
+
+        auto top = head_.load(std::memory_order_relaxed);
+        do {
+            arena_.link(index).store(top, std::memory_order_relaxed);
+        } while (!head_.compare_exchange_weak(top, detail::relink(top, index),
+                                              std::memory_order_release,
+                                              std::memory_order_relaxed));
+
+        return true;
+    }
+
+    template<typename T>
+    std::optional<T> ConcurrentStack<T>::pop()
+    {
+        auto top = head_.load(std::memory_order_acquire);
+
+        for (; ; ) {
+            const auto index = detail::index_of(top);
+            if (index == detail::nil) return std::nullopt;
+
+            const auto next = arena_.link(index)
+                                    .load(std::memory_order_relaxed);
+
+            if (head_.compare_exchange_weak(
+                        top, detail::relink(top, detail::index_of(next)),
+                        std::memory_order_acquire,
+                        std::memory_order_acquire)) {
+                std::optional<T> ret {std::move(arena_.node(index).key)};
+                arena_.release(index);
+                return ret;
+            }
+        }
+    }
+
+    // A bounded lock-free FIFO queue for any number of producers and
+    // consumers. T must be default constructible and move assignable. Nodes
+    // are recycled slightly after values leave, so while pops are in progress
+    // push may briefly report the queue full before it reaches capacity.
+    template<typename T>
+    class ConcurrentQueue {
+    public:
+        explicit ConcurrentQueue(std::size_t capacity);
+
+        // Returns false, without enqueueing, if the queue is full.
+        bool push(T value);
+
+        std::optional<T> pop();
+
+    private:
+        // A node goes back to the free list after two things have happened:
+        // its value was moved out, and it stopped being the dummy head node.
+        // Those happen in either order, in different threads.
+        void retire(std::uint32_t index) noexcept;
+
+        detail::NodeArena<T> arena_;
+        std::unique_ptr<std::atomic<unsigned char>[]> retirements_;
+        std::atomic<detail::Link> head_;
+        std::atomic<detail::Link> tail_;
+    };
+
+    template<typename T>
+    ConcurrentQueue<T>::ConcurrentQueue(const std::size_t capacity)
+        : arena_{capacity + 1u},
+          retirements_{new std::atomic<unsigned char>[capacity + 1u]}
+    {
+        const auto dummy = arena_.acquire();
+        arena_.link(dummy).store(detail::make_link(detail::nil, 0u));
+        retirements_[dummy].store(1u); // It has no value to move out.
+
+        head_.store(detail::make_link(dummy, 0u));
+        tail_.store(detail::make_link(dummy, 0u));
+    }
+
+    template<typename T>
+    bool ConcurrentQueue<T>::push(T value)
+    {
+        using detail::index_of, detail::nil, detail::relink;
+
+        const auto index = arena_.acquire();
+        if (index == nil) return false;
+
+        arena_.node(index).key = std::move(value);
+        retirements_[index].store(0u, std::memory_order_relaxed);
+
+        auto& link = arena_.link(index);
+        link.store(relink(link.load(std::memory_order_relaxed), nil),
+                   std::memory_order_relaxed);
+
+        for (; ; ) {
+            auto tail = tail_.load(std::memory_order_acquire);
+            auto next = arena_.link(index_of(tail))
+                              .load(std::memory_order_acquire);
+
+            if (tail != tail_.load(std::memory_order_acquire)) continue;
+
+            if (index_of(next) == nil) {
+                if (arena_.link(index_of(tail)).compare_exchange_strong(
+                            next, relink(next, index),
+                            std::memory_order_release,
+                            std::memory_order_relaxed)) {
+                    tail_.compare_exchange_strong(tail, relink(tail, index),
+                                                  std::memory_order_release,
+                                                  std::memory_order_relaxed);
+                    return true;
+                }
+            } else {
+                // The tail is lagging. Help the other enqueuer swing it.
+                tail_.compare_exchange_strong(tail,
+                                              relink(tail, index_of(next)),
+                                              std::memory_order_release,
+                                              std::memory_order_relaxed);
+            }
+        }
+    }
+
+    template<typename T>
+    std::optional<T> ConcurrentQueue<T>::pop()
+    {
+        using detail::index_of, detail::nil, detail::relink;
+
+        for (; ; ) {
+            auto head = head_.load(std::memory_order_acquire);
+            auto tail = tail_.load(std::memory_order_acquire);
+            const auto next = arena_.link(index_of(head))
+                                    .load(std::memory_order_acquire);
+
+            if (head != head_.load(std::memory_order_acquire)) continue;
+
+            if (index_of(head) == index_of(tail)) {
+                if (index_of(next) == nil) return std::nullopt;
+
+                tail_.compare_exchange_strong(tail,
+                                              relink(tail, index_of(next)),
+                                              std::memory_order_release,
+                                              std::memory_order_relaxed);
+            } else if (head_.compare_exchange_strong(
+                            head, relink(head, index_of(next)),
+                            std::memory_order_acq_rel,
+                            std::memory_order_relaxed)) {
+                // Now next is the dummy node, and its value is ours.
+                std::optional<T> ret {
+                        std::move(arena_.node(index_of(next)).key)};
+                retire(index_of(next));
+                retire(index_of(head));
+                return ret;
+            }
+        }
+    }
+
+    template<typename T>
+    void ConcurrentQueue<T>::retire(const std::uint32_t index) noexcept
+    {
+        if (retirements_[index].fetch_add(1u, std::memory_order_acq_rel) == 1u)
+            arena_.release(index);
+    }
+}
+
+#endif // ! HAVE_POOL_CONCURRENT_HPP_
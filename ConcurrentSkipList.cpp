@@ -0,0 +1,4 @@
+// A lock-free ordered set built as a skip list of Pool-allocated towers.
+// SPDX-License-Identifier: 0BSD
+
+#include "ConcurrentSkipList.hpp"
@@ -0,0 +1,476 @@
+// A lock-free ordered set: a skip list whose towers of links are allocated
+// from a Pool up front and recycled once they are no longer reachable.
+//
+// Copyright (c) 2018 Eliah Kagan
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+// SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+// OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+// CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef HAVE_POOL_CONCURRENTSKIPLIST_HPP_
+#define HAVE_POOL_CONCURRENTSKIPLIST_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include "Pool.hpp"
+#include "View.hpp"
+
+namespace ek {
+    namespace detail {
+        // Each level has a quarter as many towers as the level below it, so
+        // this many levels suffice for billions of keys.
+        inline constexpr std::size_t skip_list_height = 16u;
+
+        // Like a ListNode, but with a link for each level it is on. The low
+        // bit of a link marks the tower as erased from that level, so that a
+        // compare-exchange can't link a new tower after an erased one.
+        // Searches mostly follow low levels' links, so those are kept next
+        // to the key, where they tend to share its cache line.
+        template<typename T>
+        struct Tower {
+            T key {};
+            std::array<std::atomic<std::uintptr_t>, skip_list_height> next {};
+            std::size_t height {};
+
+            // Links towers that are free, or erased but not yet recycled.
+            std::atomic<Tower*> spare {};
+        };
+    }
+
+    // A set of keys ordered by f, whose insert, erase, and contains are
+    // lock-free and take O(log n) expected time. This is the lock-free skip
+    // list of Herlihy and Shavit (after Fraser and Harris). At most capacity
+    // keys can be in it at once, and T must be default constructible and
+    // copy assignable.
+    //
+    // Erased towers may still be read by other threads' traversals, so they
+    // aren't reused right away. Calling reclaim() when no other thread is
+    // using the skip list recycles them. Iteration is weakly consistent: it
+    // sees each key that is present throughout, and may or may not see keys
+    // inserted or erased meanwhile.
+    template<typename T, typename F = std::less<T>>
+    class ConcurrentSkipList {
+        using Tower = detail::Tower<T>;
+
+    public:
+        class const_iterator;
+
+        explicit ConcurrentSkipList(std::size_t capacity, F f = F{});
+
+        ConcurrentSkipList(const ConcurrentSkipList&) = delete;
+        ConcurrentSkipList& operator=(const ConcurrentSkipList&) = delete;
+
+        // Returns false, without inserting, if the key is already present.
+        // Throws std::length_error if no towers are free.
+        bool insert(const T& key);
+
+        // Returns false if the key wasn't present.
+        bool erase(const T& key);
+
+        bool contains(const T& key) const;
+
+        // Exact if no insert or erase is in progress.
+        std::size_t size() const noexcept
+        {
+            return size_.load(std::memory_order_relaxed);
+        }
+
+        const_iterator begin() const;
+        const_iterator end() const noexcept { return const_iterator{}; }
+
+        // The first key not ordered before key.
+        const_iterator lower_bound(const T& key) const;
+
+        // A view (see View.hpp) of the keys in [low, high).
+        auto range(const T& low, const T& high) const
+        {
+            return take_while(RangeView{lower_bound(low), end()},
+                              [f = f_, high](const T& key) {
+                return f(key, high);
+            });
+        }
+
+        // Finishes unlinking erased towers and makes them free for reuse.
+        // No other thread may be using the skip list during this call.
+        void reclaim();
+
+    private:
+        static constexpr auto max_height = detail::skip_list_height;
+
+        static Tower* ptr(const std::uintptr_t link) noexcept
+        {
+            return reinterpret_cast<Tower*>(link & ~std::uintptr_t{1u});
+        }
+
+        static bool is_marked(const std::uintptr_t link) noexcept
+        {
+            return (link & 1u) != 0u;
+        }
+
+        static std::uintptr_t pack(const Tower* const tower) noexcept
+        {
+            return reinterpret_cast<std::uintptr_t>(tower);
+        }
+
+        static std::size_t random_height();
+
+        // Finds each level's last tower ordered before the key, and the tower
+        // after it, unlinking erased towers along the way. Returns whether
+        // the key is present.
+        bool find(const T& key, Tower** preds, Tower** succs);
+
+        // Like find, but returns nullopt if a concurrent change interferes.
+        std::optional<bool> try_find(const T& key, Tower** preds,
+                                     Tower** succs);
+
+        Tower* allocate();
+
+        void retire(Tower* tower) noexcept;
+
+        Pool<Tower> pool_;
+        Tower head_;
+        std::atomic<Tower*> free_ {};
+        std::atomic<Tower*> retired_ {};
+        std::atomic<std::size_t> size_ {};
+        F f_;
+    };
+
+    template<typename T, typename F>
+    class ConcurrentSkipList<T, F>::const_iterator {
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = T;
+        using pointer = const T*;
+        using reference = const T&;
+        using iterator_category = std::forward_iterator_tag;
+
+        friend bool
+        operator==(const const_iterator& lhs, const const_iterator& rhs)
+            noexcept
+        {
+            return lhs.pos_ == rhs.pos_;
+        }
+
+        friend bool
+        operator!=(const const_iterator& lhs, const const_iterator& rhs)
+            noexcept
+        {
+            return lhs.pos_ != rhs.pos_;
+        }
+
+        explicit const_iterator(const Tower* const pos = nullptr) noexcept
+            : pos_{skip(pos)} { }
+
+        const_iterator& operator++() noexcept
+        {
+            pos_ = skip(ptr(pos_->next[0].load(std::memory_order_acquire)));
+            return *this;
+        }
+
+        const_iterator operator++(int) noexcept
+        {
+            const auto ret = *this;
+            ++*this;
+            return ret;
+        }
+
+        reference operator*() const noexcept { return pos_->key; }
+
+        pointer operator->() const noexcept { return &pos_->key; }
+
+    private:
+        // Skips towers that are erased from the bottom level.
+        static const Tower* skip(const Tower* pos) noexcept
+        {
+            for (; pos; pos = ptr(pos->next[0].load(std::memory_order_acquire)))
+                if (!is_marked(pos->next[0].load(std::memory_order_acquire)))
+                    break;
+
+            return pos;
+        }
+
+        const Tower* pos_;
+    };
+
+    template<typename T, typename F>
+    ConcurrentSkipList<T, F>::ConcurrentSkipList(const std::size_t capacity,
+                                                 const F f)
+        : f_{f}
+    {
+        head_.height = max_height;
+
+        for (auto i = capacity; i != 0u; --i) {
+            const auto tower = pool_();
+            tower->spare.store(free_.load(std::memory_order_relaxed),
+                               std::memory_order_relaxed);
+            free_.store(tower, std::memory_order_relaxed);
+        }
+    }
+
+    template<typename T, typename F>
+    bool ConcurrentSkipList<T, F>::insert(const T& key)
+    {
+        Tower* preds[max_height];
+        Tower* succs[max_height];
+        Tower* tower {};
+
+        // Link the new tower on the bottom level. That is when it is added.
+        for (; ; ) {
+            if (find(key, preds, succs)) {
+                if (tower) retire(tower); // Other threads never saw it.
+                return false;
+            }
+
+            if (!tower) {
+                tower = allocate();
+                tower->key = key;
+                tower->height = random_height();
+            }
+
+            for (auto level = std::size_t{0u}; level != tower->height; ++level)
+                tower->next[level].store(pack(succs[level]),
+                                         std::memory_order_relaxed);
+
+            auto expected = pack(succs[0]);
+            if (preds[0]->next[0].compare_exchange_strong(
+                        expected, pack(tower),
+                        std::memory_order_release,
+                        std::memory_order_relaxed))
+                break;
+        }
+
+        size_.fetch_add(1u, std::memory_order_relaxed);
+
+        // Link it on higher levels, which only speeds up searches. If it is
+        // erased meanwhile, its links are marked, and we stop.
+        for (auto level = std::size_t{1u}; level != tower->height; ++level) {
+            for (; ; ) {
+                auto link = tower->next[level].load(std::memory_order_acquire);
+                if (is_marked(link)) return true;
+
+                if (ptr(link) != succs[level]
+                        && !tower->next[level].compare_exchange_strong(
+                                link, pack(succs[level]),
+                                std::memory_order_release,
+                                std::memory_order_relaxed))
+                    continue;
+
+                auto expected = pack(succs[level]);
+                if (preds[level]->next[level].compare_exchange_strong(
+                            expected, pack(tower),
+                            std::memory_order_release,
+                            std::memory_order_relaxed))
+                    break;
+
+                find(key, preds, succs);
+            }
+        }
+
+        return true;
+    }
+
+    template<typename T, typename F>
+    bool ConcurrentSkipList<T, F>::erase(const T& key)
+    {
+        Tower* preds[max_height];
+        Tower* succs[max_height];
+
+        if (!find(key, preds, succs)) return false;
+        const auto victim = succs[0];
+
+        // Mark the upper levels' links from the top down, then the bottom
+        // level's, which is when the key is erased.
+        for (auto level = victim->height; level-- > 1u; ) {
+            auto link = victim->next[level].load(std::memory_order_acquire);
+            while (!is_marked(link)) {
+                victim->next[level].compare_exchange_weak(
+                        link, link | 1u,
+                        std::memory_order_acq_rel,
+                        std::memory_order_acquire);
+            }
+        }
+
+        auto link = victim->next[0].load(std::memory_order_acquire);
+
+        for (; ; ) {
+            if (is_marked(link)) return false; // Another thread erased it.
+
+            if (victim->next[0].compare_exchange_weak(
+                        link, link | 1u,
+                        std::memory_order_acq_rel,
+                        std::memory_order_acquire)) {
+                find(key, preds, succs); // to unlink it
+                size_.fetch_sub(1u, std::memory_order_relaxed);
+                retire(victim);
+                return true;
+            }
+        }
+    }
+
+    template<typename T, typename F>
+    bool ConcurrentSkipList<T, F>::contains(const T& key) const
+    {
+        const auto pos = lower_bound(key);
+        return pos != end() && !f_(key, *pos);
+    }
+
+    template<typename T, typename F>
+    auto ConcurrentSkipList<T, F>::begin() const -> const_iterator
+    {
+        return const_iterator{
+                ptr(head_.next[0].load(std::memory_order_acquire))};
+    }
+
+    template<typename T, typename F>
+    auto ConcurrentSkipList<T, F>::lower_bound(const T& key) const
+        -> const_iterator
+    {
+        // This passes over erased towers rather than unlinking them.
+        const Tower* pred = &head_;
+        const Tower* curr {};
+
+        for (auto level = max_height; level-- != 0u; ) {
+            curr = ptr(pred->next[level].load(std::memory_order_acquire));
+
+            while (curr) {
+                const auto link =
+                        curr->next[level].load(std::memory_order_acquire);
+
+                if (!is_marked(link) && !f_(curr->key, key)) break;
+                if (!is_marked(link)) pred = curr;
+                curr = ptr(link);
+            }
+        }
+
+        return const_iterator{curr};
+    }
+
+    template<typename T, typename F>
+    void ConcurrentSkipList<T, F>::reclaim()
+    {
+        for (auto level = std::size_t{0u}; level != max_height; ++level) {
+            auto pred = &head_;
+
+            while (const auto curr = ptr(pred->next[level].load())) {
+                const auto link = curr->next[level].load();
+                if (is_marked(link)) pred->next[level].store(pack(ptr(link)));
+                else pred = curr;
+            }
+        }
+
+        while (const auto tower = retired_.load()) {
+            retired_.store(tower->spare.load());
+            tower->spare.store(free_.load());
+            free_.store(tower);
+        }
+    }
+
+    template<typename T, typename F>
+    std::size_t ConcurrentSkipList<T, F>::random_height()
+    {
+        thread_local std::mt19937 gen {std::random_device{}()};
+
+        // Each pair of random bits that are both 0 adds a level.
+        auto bits = gen();
+        auto height = std::size_t{1u};
+
+        for (; height != max_height && (bits & 3u) == 0u; bits >>= 2u)
+            ++height;
+
+        return height;
+    }
+
+    template<typename T, typename F>
+    bool ConcurrentSkipList<T, F>::find(const T& key, Tower** const preds,
+                                        Tower** const succs)
+    {
+        for (; ; )
+            if (const auto found = try_find(key, preds, succs)) return *found;
+    }
+
+    template<typename T, typename F>
+    std::optional<bool>
+    ConcurrentSkipList<T, F>::try_find(const T& key, Tower** const preds,
+                                       Tower** const succs)
+    {
+        auto pred = &head_;
+        Tower* curr {};
+
+        for (auto level = max_height; level-- != 0u; ) {
+            curr = ptr(pred->next[level].load(std::memory_order_acquire));
+
+            while (curr) {
+                const auto link =
+                        curr->next[level].load(std::memory_order_acquire);
+
+                if (is_marked(link)) {
+                    // curr is erased, so unlink it from this level. If pred
+                    // changed or was erased too, start over.
+                    auto expected = pack(curr);
+                    if (!pred->next[level].compare_exchange_strong(
+                                expected, pack(ptr(link)),
+                                std::memory_order_acq_rel,
+                                std::memory_order_relaxed))
+                        return std::nullopt;
+
+                    curr = ptr(link);
+                } else if (f_(curr->key, key)) {
+                    pred = curr;
+                    curr = ptr(link);
+                } else {
+                    break;
+                }
+            }
+
+            preds[level] = pred;
+            succs[level] = curr;
+        }
+
+        return curr && !f_(key, curr->key);
+    }
+
+    template<typename T, typename F>
+    auto ConcurrentSkipList<T, F>::allocate() -> Tower*
+    {
+        // Towers are only put back on the free list by reclaim, when no
+        // other thread is running, so this pop can't suffer from ABA.
+        auto tower = free_.load(std::memory_order_acquire);
+
+        while (tower && !free_.compare_exchange_weak(
+                                tower,
+                                tower->spare.load(std::memory_order_relaxed),
+                                std::memory_order_acquire,
+                                std::memory_order_acquire)) { }
+
+        if (!tower) throw std::length_error{"skip list has no free towers"};
+        return tower;
+    }
+
+    template<typename T, typename F>
+    void ConcurrentSkipList<T, F>::retire(Tower* const tower) noexcept
+    {
+        auto top = retired_.load(std::memory_order_relaxed);
+
+        do {
+            tower->spare.store(top, std::memory_order_relaxed);
+        } while (!retired_.compare_exchange_weak(top, tower,
+                                                 std::memory_order_release,
+                                                 std::memory_order_relaxed));
+    }
+}
+
+#endif // ! HAVE_POOL_CONCURRENTSKIPLIST_HPP_
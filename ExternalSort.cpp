@@ -0,0 +1,76 @@
+// External merge sort of binary records with ListNode runs - implementation
+// file.
+//
+// Copyright (c) 2018 Eliah Kagan
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+// SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+// OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+// CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include "ExternalSort.hpp"
+
+#include <atomic>
+#include <random>
+#include <system_error>
+
+namespace ek::detail {
+    namespace {
+        std::filesystem::path make_spill_path()
+        {
+            static std::atomic<unsigned long long> counter {};
+
+            std::random_device device;
+            const auto name = "ek-sort-" + std::to_string(device()) + "-"
+                                + std::to_string(++counter) + ".tmp";
+
+            return std::filesystem::temp_directory_path() / name;
+        }
+    }
+
+    SpillFile::SpillFile() : path_{make_spill_path()}
+    {
+        stream_.open(path_, std::ios::in | std::ios::out | std::ios::binary
+                                | std::ios::trunc);
+        if (!stream_)
+            throw std::runtime_error{"can't create " + path_.string()};
+    }
+
+    SpillFile::~SpillFile()
+    {
+        stream_.close();
+
+        std::error_code ec;
+        std::filesystem::remove(path_, ec);
+    }
+
+    std::uint64_t SpillFile::append(const char* const data,
+                                    const std::size_t count)
+    {
+        const std::lock_guard lock {mutex_};
+
+        const auto offset = size_;
+        stream_.seekp(static_cast<std::streamoff>(offset));
+        if (!stream_.write(data, static_cast<std::streamsize>(count)))
+            throw std::runtime_error{"can't write " + path_.string()};
+
+        size_ += count;
+        return offset;
+    }
+
+    void SpillFile::read(const std::uint64_t offset, char* const data,
+                         const std::size_t count)
+    {
+        const std::lock_guard lock {mutex_};
+
+        stream_.seekg(static_cast<std::streamoff>(offset));
+        if (!stream_.read(data, static_cast<std::streamsize>(count)))
+            throw std::runtime_error{"can't read " + path_.string()};
+    }
+}
@@ -0,0 +1,396 @@
+// External merge sort of binary records too many to fit in memory at once,
+// by sorting ListNode runs in memory and merging them from temporary files.
+//
+// Copyright (c) 2018 Eliah Kagan
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+// SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+// OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+// CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef HAVE_POOL_EXTERNALSORT_HPP_
+#define HAVE_POOL_EXTERNALSORT_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "ListNode.hpp"
+
+namespace ek {
+    namespace detail {
+        // A temporary file of records, deleted when this is destroyed. Runs
+        // are appended one after another. Reads, which may come from other
+        // threads, and appends are serialized.
+        class SpillFile {
+        public:
+            SpillFile();
+            ~SpillFile();
+
+            SpillFile(const SpillFile&) = delete;
+            SpillFile& operator=(const SpillFile&) = delete;
+
+            // Returns the offset at which the bytes were written.
+            std::uint64_t append(const char* data, std::size_t count);
+
+            void read(std::uint64_t offset, char* data, std::size_t count);
+
+        private:
+            std::filesystem::path path_;
+            std::fstream stream_;
+            std::uint64_t size_ {};
+            std::mutex mutex_;
+        };
+
+        // A sorted run of records in a spill file.
+        struct Run {
+            std::uint64_t offset;
+            std::uint64_t count;
+        };
+
+        // Memory beyond the nodes being sorted or merged goes to blocks of
+        // roughly this size, and merges read runs in blocks no smaller.
+        inline constexpr std::size_t min_block_bytes = 4096u;
+
+        // Collects records into a block and hands it to a sink when full.
+        template<typename T, typename S>
+        class BlockWriter {
+        public:
+            BlockWriter(const std::size_t capacity, S sink)
+                : sink_{sink} { block_.reserve(capacity); }
+
+            void push(const T& record)
+            {
+                block_.push_back(record);
+                if (block_.size() == block_.capacity()) flush();
+            }
+
+            void flush()
+            {
+                if (block_.empty()) return;
+                sink_(reinterpret_cast<const char*>(block_.data()),
+                      block_.size() * sizeof(T));
+                block_.clear();
+            }
+
+        private:
+            std::vector<T> block_;
+            S sink_;
+        };
+
+        // Reads a run in blocks, each loaded into ListNode objects linked in
+        // order, with the last node's link null. While the merge consumes
+        // one block, the next is read asynchronously into the other buffer.
+        template<typename T>
+        class RunReader {
+        public:
+            RunReader(SpillFile& file, Run run, std::size_t block);
+
+            RunReader(const RunReader&) = delete;
+            RunReader& operator=(const RunReader&) = delete;
+
+            ListNode<T>* head() noexcept { return &nodes_[current_][0]; }
+
+            bool empty() const noexcept { return run_.count == 0u; }
+
+            // Waits for the next block and makes it current. Returns its
+            // first node, or null if the run is exhausted.
+            ListNode<T>* next_block();
+
+            // Starts reading the block after the current one into the other
+            // buffer, whose nodes must no longer be in use.
+            void prefetch();
+
+        private:
+            void load(std::size_t buffer, std::uint64_t count);
+
+            SpillFile& file_;
+            Run run_;
+            std::uint64_t loaded_ {};
+            std::size_t block_;
+            std::size_t current_ {};
+            std::vector<T> records_[2];
+            std::vector<ListNode<T>> nodes_[2];
+            std::future<void> pending_;
+        };
+
+        template<typename T>
+        RunReader<T>::RunReader(SpillFile& file, const Run run,
+                                const std::size_t block)
+            : file_{file}, run_{run}, block_{block}
+        {
+            for (auto i = 0u; i != 2u; ++i) {
+                records_[i].resize(block);
+                nodes_[i].resize(block);
+            }
+
+            if (run.count == 0u) return;
+
+            load(current_, std::min(run_.count, std::uint64_t{block_}));
+            prefetch();
+        }
+
+        template<typename T>
+        ListNode<T>* RunReader<T>::next_block()
+        {
+            if (!pending_.valid()) return nullptr;
+
+            pending_.get();
+            current_ = 1u - current_;
+            return head();
+        }
+
+        template<typename T>
+        void RunReader<T>::prefetch()
+        {
+            const auto count = std::min(run_.count - loaded_,
+                                        std::uint64_t{block_});
+            if (count == 0u) return;
+
+            pending_ = std::async(std::launch::async,
+                                  &RunReader::load, this, 1u - current_,
+                                  count);
+        }
+
+        template<typename T>
+        void RunReader<T>::load(const std::size_t buffer,
+                                const std::uint64_t count)
+        {
+            const auto n = static_cast<std::size_t>(count);
+            auto& records = records_[buffer];
+            auto& nodes = nodes_[buffer];
+
+            file_.read(run_.offset + loaded_ * sizeof(T),
+                       reinterpret_cast<char*>(records.data()),
+                       n * sizeof(T));
+            loaded_ += count;
+
+            for (auto i = std::size_t{0u}; i != n; ++i) {
+                nodes[i].key = records[i];
+                nodes[i].next = &nodes[i + 1u];
+            }
+            nodes[n - 1u].next = nullptr;
+        }
+
+        // Merges runs, which must be in their input order for stability,
+        // and passes each record, in order, to the writer.
+        template<typename T, typename F, typename W>
+        void merge_runs(SpillFile& file, const std::vector<Run>& runs,
+                        const std::size_t block, const F f, W& writer)
+        {
+            std::vector<std::unique_ptr<RunReader<T>>> readers;
+            std::vector<ListNode<T>*> heads;
+
+            for (const auto& run : runs) {
+                readers.push_back(
+                        std::make_unique<RunReader<T>>(file, run, block));
+                heads.push_back(readers.back()->empty()
+                                    ? nullptr : readers.back()->head());
+            }
+
+            LoserTree<T, F> tree {cbegin(heads), cend(heads), f};
+
+            // Before the merge takes the last node of a block, link it to the
+            // next block, so the tree goes on to that block's nodes. Once the
+            // node's record is written, its buffer is free to read into.
+            while (const auto node = tree.top()) {
+                const auto run = tree.top_run();
+                const auto last = !node->next;
+                if (last) node->next = readers[run]->next_block();
+
+                tree.pop();
+                writer.push(node->key);
+                if (last) readers[run]->prefetch();
+            }
+        }
+    }
+
+    // Reads records of type T from in, sorts them stably by f, and writes
+    // them to out. Both streams should be binary. At most about
+    // memory_budget bytes are used for records and nodes. Chunks that fit in
+    // that are sorted as ListNode lists and spilled to temporary files as
+    // runs. Then runs are merged in passes, as many at a time as the budget
+    // allows reading in double-buffered blocks, until a last merge writes
+    // the output. Failures to read or write throw std::runtime_error.
+    template<typename T, typename F = std::less<T>>
+    void external_sort(std::istream& in, std::ostream& out,
+                       const std::size_t memory_budget, const F f = F{})
+    {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "records are read and written as raw bytes");
+
+        using Node = ListNode<T>;
+        constexpr auto record_bytes = sizeof(Node) + sizeof(T);
+        constexpr auto min_block = std::max(std::size_t{1u},
+                                            detail::min_block_bytes
+                                                / record_bytes);
+
+        const auto write_out = [&out](const char* const data,
+                                      const std::size_t count) {
+            if (!out.write(data, static_cast<std::streamsize>(count)))
+                throw std::runtime_error{"can't write sorted output"};
+        };
+
+        // Form runs. The staging block is for reading and writing records.
+        const auto chunk = std::max(std::size_t{1u},
+                                    (memory_budget
+                                        - std::min(memory_budget,
+                                                   min_block * sizeof(T)))
+                                        / sizeof(Node));
+
+        std::vector<Node> nodes (chunk);
+        std::vector<T> staging (min_block);
+        auto file = std::make_unique<detail::SpillFile>();
+        std::vector<detail::Run> runs;
+
+        for (auto exhausted = false; !exhausted; ) {
+            auto count = std::size_t{0u};
+
+            while (count != chunk && !exhausted) {
+                const auto want = std::min(min_block, chunk - count);
+                in.read(reinterpret_cast<char*>(staging.data()),
+                        static_cast<std::streamsize>(want * sizeof(T)));
+
+                const auto bytes = static_cast<std::size_t>(in.gcount());
+                if (bytes % sizeof(T) != 0u)
+                    throw std::runtime_error{"input ends in a partial record"};
+
+                for (auto i = std::size_t{0u}; i != bytes / sizeof(T); ++i)
+                    nodes[count++] = Node{staging[i], nullptr};
+
+                if (!in) {
+                    if (in.bad()) throw std::runtime_error{"can't read input"};
+                    exhausted = true;
+                }
+            }
+
+            if (!exhausted) {
+                exhausted = (in.peek() == std::istream::traits_type::eof());
+                if (in.bad()) throw std::runtime_error{"can't read input"};
+            }
+
+            if (count == 0u) break;
+
+            for (auto i = std::size_t{1u}; i != count; ++i)
+                nodes[i - 1u].next = &nodes[i];
+
+            const auto head = sort(&nodes[0], f);
+
+            // If everything fit in one chunk, it goes straight to the output.
+            if (runs.empty() && exhausted) {
+                detail::BlockWriter<T, decltype(write_out)> writer {
+                        min_block, write_out};
+                for (auto node = head; node; node = node->next)
+                    writer.push(node->key);
+                writer.flush();
+                return;
+            }
+
+            detail::Run run {0u, count};
+            auto started = false;
+            const auto spill = [&](const char* const data,
+                                   const std::size_t bytes) {
+                const auto at = file->append(data, bytes);
+                if (!started) run.offset = at;
+                started = true;
+            };
+
+            detail::BlockWriter<T, decltype(spill)> writer {min_block, spill};
+            for (auto node = head; node; node = node->next)
+                writer.push(node->key);
+            writer.flush();
+
+            runs.push_back(run);
+        }
+
+        if (runs.empty()) return;
+        nodes = std::vector<Node>{};
+
+        // Merge, with each run getting two blocks, and the output one more.
+        const auto fan_in = std::max(std::size_t{2u},
+                                     memory_budget
+                                        / (2u * min_block * record_bytes));
+
+        const auto block_for = [min_block, memory_budget](const std::size_t k) {
+            return std::max(min_block,
+                            memory_budget
+                                / (2u * k * record_bytes + sizeof(T)));
+        };
+
+        while (runs.size() > fan_in) {
+            auto next_file = std::make_unique<detail::SpillFile>();
+            std::vector<detail::Run> next_runs;
+
+            for (auto first = cbegin(runs); first != cend(runs); ) {
+                const auto last = first + static_cast<std::ptrdiff_t>(
+                        std::min(fan_in, static_cast<std::size_t>(
+                                                cend(runs) - first)));
+
+                const std::vector<detail::Run> group (first, last);
+                const auto block = block_for(group.size());
+
+                detail::Run merged {0u, 0u};
+                auto started = false;
+                const auto spill = [&](const char* const data,
+                                       const std::size_t bytes) {
+                    const auto at = next_file->append(data, bytes);
+                    if (!started) merged.offset = at;
+                    started = true;
+                    merged.count += bytes / sizeof(T);
+                };
+
+                detail::BlockWriter<T, decltype(spill)> writer {block, spill};
+                detail::merge_runs<T>(*file, group, block, f, writer);
+                writer.flush();
+
+                next_runs.push_back(merged);
+                first = last;
+            }
+
+            file = std::move(next_file);
+            runs = std::move(next_runs);
+        }
+
+        const auto block = block_for(runs.size());
+        detail::BlockWriter<T, decltype(write_out)> writer {block, write_out};
+        detail::merge_runs<T>(*file, runs, block, f, writer);
+        writer.flush();
+    }
+
+    // Sorts the binary file at input_path into a file at output_path.
+    template<typename T, typename F = std::less<T>>
+    void external_sort(const std::string& input_path,
+                       const std::string& output_path,
+                       const std::size_t memory_budget, const F f = F{})
+    {
+        std::ifstream in {input_path, std::ios::binary};
+        if (!in) throw std::runtime_error{"can't open " + input_path};
+
+        std::ofstream out {output_path, std::ios::binary | std::ios::trunc};
+        if (!out) throw std::runtime_error{"can't open " + output_path};
+
+        external_sort<T>(in, out, memory_budget, f);
+
+        out.close();
+        if (!out) throw std::runtime_error{"can't write " + output_path};
+    }
+}
+
+#endif // ! HAVE_POOL_EXTERNALSORT_HPP_
@@ -0,0 +1,4 @@
+// Helpers for open-addressed hash tables.
+// SPDX-License-Identifier: 0BSD
+
+#include "Hash.hpp"
@@ -0,0 +1,115 @@
+// Helpers for the open-addressed hash tables in this project.
+//
+// Copyright (c) 2018 Eliah Kagan
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+// SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+// OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+// CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef HAVE_POOL_HASH_HPP_
+#define HAVE_POOL_HASH_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace ek::detail {
+    // Scrambles a hash so its low bits depend on all its bits. Tables index
+    // slots by the low bits, and std::hash is often the identity on integers
+    // and nearly so on pointers, which would put nearby keys into one long
+    // cluster of linear probes. This is the 64-bit MurmurHash3 finalizer.
+    constexpr std::size_t mix_hash(const std::size_t h) noexcept
+    {
+        auto x = static_cast<std::uint64_t>(h);
+        x ^= x >> 33u;
+        x *= 0xff51afd7ed558ccdu;
+        x ^= x >> 33u;
+        x *= 0xc4ceb9fe1a85ec53u;
+        x ^= x >> 33u;
+        return static_cast<std::size_t>(x);
+    }
+
+    // Mixes another hash into a running one, as in boost::hash_combine.
+    constexpr std::size_t combine_hash(const std::size_t seed,
+                                       const std::size_t h) noexcept
+    {
+        return seed ^ (h + 0x9e3779b9u + (seed << 6u) + (seed >> 2u));
+    }
+
+    // Slot tables use open addressing with linear probing, over a vector of
+    // slots whose size is a power of two. A slot is a struct with a hash
+    // member, holding the mixed hash, and a node member, which is null when
+    // the slot is empty. The table is kept at most half full, and erasing
+    // shifts entries back rather than leaving tombstones.
+
+    // Finds the slot in the probe sequence for h whose hash is h and for
+    // which match(slot) is true, or the empty slot where it would go.
+    template<typename S, typename F>
+    std::size_t probe_slot(const std::vector<S>& slots, const std::size_t h,
+                           F match)
+    {
+        const auto mask = slots.size() - 1u;
+
+        auto i = h & mask;
+        for (; slots[i].node; i = (i + 1u) & mask)
+            if (slots[i].hash == h && match(slots[i])) break;
+
+        return i;
+    }
+
+    // Puts an entry whose key is not yet in the table in the first free slot.
+    template<typename S>
+    void place_slot(std::vector<S>& slots, const S& entry) noexcept
+    {
+        const auto mask = slots.size() - 1u;
+
+        auto i = entry.hash & mask;
+        while (slots[i].node) i = (i + 1u) & mask;
+        slots[i] = entry;
+    }
+
+    // Empties a slot by backward-shift deletion: later entries of the probe
+    // sequence move into the hole, so lookups never need tombstones.
+    template<typename S>
+    void erase_slot(std::vector<S>& slots, std::size_t hole) noexcept
+    {
+        const auto mask = slots.size() - 1u;
+        slots[hole].node = nullptr;
+
+        for (auto i = (hole + 1u) & mask; slots[i].node; i = (i + 1u) & mask) {
+            const auto home = slots[i].hash & mask;
+            if (((i - home) & mask) >= ((i - hole) & mask)) {
+                slots[hole] = slots[i];
+                slots[i].node = nullptr;
+                hole = i;
+            }
+        }
+    }
+
+    // Grows the table, if needed, so count entries keep the load factor at
+    // most 1/2, and reinserts the entries. A table has at least 16 slots.
+    template<typename S>
+    void reserve_slots(std::vector<S>& slots, const std::size_t count)
+    {
+        auto capacity = std::max(slots.size(), std::size_t{16u});
+        while (capacity < count * 2u) capacity *= 2u;
+        if (capacity == slots.size()) return;
+
+        std::vector<S> old (capacity);
+        swap(old, slots);
+
+        for (const auto& entry : old)
+            if (entry.node) place_slot(slots, entry);
+    }
+}
+
+#endif // ! HAVE_POOL_HASH_HPP_
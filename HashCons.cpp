@@ -0,0 +1,4 @@
+// Hash-consed immutable ListNode lists.
+// SPDX-License-Identifier: 0BSD
+
+#include "HashCons.hpp"
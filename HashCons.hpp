@@ -0,0 +1,131 @@
+// Hash-consed immutable ListNode lists, in which equal suffixes are always
+// the same nodes, so equal lists are equal pointers.
+//
+// Copyright (c) 2018 Eliah Kagan
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+// SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+// OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+// CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef HAVE_POOL_HASHCONS_HPP_
+#define HAVE_POOL_HASHCONS_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Hash.hpp"
+#include "ListNode.hpp"
+#include "Pool.hpp"
+
+namespace ek {
+    // Makes and owns immutable lists. A node is only made if no node with an
+    // equal key and the same next pointer exists yet, so two lists from the
+    // same table are equal exactly when their heads are the same pointer, and
+    // meet_node on them finds their longest common suffix. Lists from
+    // different tables, or not from a table, must not be mixed.
+    template<typename T, typename H = std::hash<T>,
+             typename E = std::equal_to<T>>
+    class ConsTable {
+    public:
+        ConsTable() = default;
+
+        explicit ConsTable(const H hash, const E key_eq = E{})
+            : hash_{hash}, key_eq_{key_eq} { }
+
+        ConsTable(const ConsTable&) = delete;
+        ConsTable& operator=(const ConsTable&) = delete;
+
+        // Returns the node with the given key and next node, making it if
+        // needed. next must be null or a node from this table.
+        const ListNode<T>* cons(const T& key, const ListNode<T>* next);
+
+        // Makes a list of the elements of [first, last), from last to first,
+        // so nodes for any suffix that was made before are reused. I must be
+        // a bidirectional iterator.
+        template<typename I>
+        const ListNode<T>* make_list(I first, I last);
+
+        template<typename C>
+        const ListNode<T>* make_list(const C& c)
+        {
+            using std::cbegin, std::cend;
+            return make_list(cbegin(c), cend(c));
+        }
+
+        const ListNode<T>* make_list(const std::initializer_list<T> ilist)
+        {
+            return make_list(std::cbegin(ilist), std::cend(ilist));
+        }
+
+        // How many distinct nodes have been made.
+        std::size_t size() const noexcept { return size_; }
+
+    private:
+        struct Slot {
+            std::size_t hash;
+            ListNode<T>* node;
+        };
+
+        std::size_t hash(const T& key, const ListNode<T>* next) const;
+
+        Pool<ListNode<T>> pool_;
+        std::vector<Slot> slots_ {};
+        std::size_t size_ {};
+        H hash_ {};
+        E key_eq_ {};
+    };
+
+    template<typename T, typename H, typename E>
+    const ListNode<T>*
+    ConsTable<T, H, E>::cons(const T& key, const ListNode<T>* const next)
+    {
+        detail::reserve_slots(slots_, size_ + 1u);
+
+        // Slots never empty out, since nodes are never removed.
+        const auto h = hash(key, next);
+        const auto i = detail::probe_slot(slots_, h, [&](const Slot& slot) {
+            return slot.node->next == next && key_eq_(slot.node->key, key);
+        });
+        if (slots_[i].node) return slots_[i].node;
+
+        // The table owns every node, including next, so it may be linked.
+        const auto node = pool_(key, const_cast<ListNode<T>*>(next));
+        slots_[i] = {h, node};
+        ++size_;
+        return node;
+    }
+
+    template<typename T, typename H, typename E>
+    template<typename I>
+    const ListNode<T>* ConsTable<T, H, E>::make_list(const I first, I last)
+    {
+        static_assert(std::is_base_of_v<
+                std::bidirectional_iterator_tag,
+                typename std::iterator_traits<I>::iterator_category>);
+
+        const ListNode<T>* head {};
+        while (last != first) head = cons(*--last, head);
+        return head;
+    }
+
+    template<typename T, typename H, typename E>
+    std::size_t ConsTable<T, H, E>::hash(const T& key,
+                                         const ListNode<T>* const next) const
+    {
+        return detail::mix_hash(detail::combine_hash(
+                hash_(key), std::hash<const void*>{}(next)));
+    }
+}
+
+#endif // ! HAVE_POOL_HASHCONS_HPP_
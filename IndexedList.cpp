@@ -0,0 +1,4 @@
+// A ListNode list of distinct keys with a hash index.
+// SPDX-License-Identifier: 0BSD
+
+#include "IndexedList.hpp"
@@ -0,0 +1,218 @@
+// A ListNode list of distinct keys with a hash index from each key to its
+// node, so finding, erasing, and checking for a key take O(1) expected time.
+//
+// Copyright (c) 2018 Eliah Kagan
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+// SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+// OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+// CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef HAVE_POOL_INDEXEDLIST_HPP_
+#define HAVE_POOL_INDEXEDLIST_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+#include "Hash.hpp"
+#include "List.hpp"
+#include "ListNode.hpp"
+#include "Pool.hpp"
+
+namespace ek {
+    // Nodes come from a Pool that must outlive the IndexedList. The index
+    // stores each node's predecessor too, so erasing from the middle of the
+    // singly linked list is O(1). Changing the list other than through these
+    // member functions makes the index stale until rebuild() is called.
+    template<typename T, typename H = std::hash<T>,
+             typename E = std::equal_to<T>>
+    class IndexedList {
+    public:
+        using iterator = typename ListNode<T>::iterator;
+
+        explicit IndexedList(Pool<ListNode<T>>& pool, const H hash = H{},
+                             const E key_eq = E{})
+            : pool_{&pool}, hash_{hash}, key_eq_{key_eq} { }
+
+        // Adopts an existing list, which must not have repeated keys.
+        IndexedList(Pool<ListNode<T>>& pool, const List<T>& list,
+                    const H hash = H{}, const E key_eq = E{})
+            : pool_{&pool}, list_{list}, hash_{hash}, key_eq_{key_eq}
+        {
+            rebuild();
+        }
+
+        IndexedList(const IndexedList&) = delete;
+        IndexedList(IndexedList&&) noexcept = default;
+        IndexedList& operator=(const IndexedList&) = delete;
+        IndexedList& operator=(IndexedList&&) noexcept = default;
+
+        const List<T>& list() const noexcept { return list_; }
+        ListNode<T>* head() const noexcept { return list_.head(); }
+        std::size_t size() const noexcept { return list_.size(); }
+        bool empty() const noexcept { return list_.empty(); }
+
+        iterator begin() const noexcept { return list_.begin(); }
+        iterator end() const noexcept { return list_.end(); }
+
+        // Returns the node with the key, or null if there is none.
+        ListNode<T>* find_node(const T& key) const;
+
+        bool contains(const T& key) const { return find_node(key); }
+
+        // These add a node with the key unless one is already present. They
+        // return that node, and whether it was added.
+        std::pair<ListNode<T>*, bool> push_front(const T& key);
+        std::pair<ListNode<T>*, bool> push_back(const T& key);
+
+        // Unlinks the node with the key. Returns whether there was one.
+        bool erase(const T& key);
+
+        // Finds the tail and size again and reindexes the whole list, such as
+        // after it was changed from outside. It must not have repeated keys.
+        void rebuild();
+
+    private:
+        struct Entry {
+            std::size_t hash;
+            ListNode<T>* node;
+            ListNode<T>* prev; // null for the head
+        };
+
+        std::size_t hash_of(const T& key) const
+        {
+            return detail::mix_hash(hash_(key));
+        }
+
+        // Finds the entry for the key, or the empty entry where it would go.
+        std::size_t probe(const T& key, std::size_t h) const;
+
+        Entry& entry_for(const ListNode<T>* node);
+
+        std::pair<ListNode<T>*, bool> push(const T& key, bool front);
+
+        Pool<ListNode<T>>* pool_;
+        List<T> list_ {};
+        std::vector<Entry> slots_ {};
+        H hash_;
+        E key_eq_;
+    };
+
+    template<typename T, typename H, typename E>
+    ListNode<T>* IndexedList<T, H, E>::find_node(const T& key) const
+    {
+        if (slots_.empty()) return nullptr;
+        return slots_[probe(key, hash_of(key))].node;
+    }
+
+    template<typename T, typename H, typename E>
+    inline std::pair<ListNode<T>*, bool>
+    IndexedList<T, H, E>::push_front(const T& key)
+    {
+        return push(key, true);
+    }
+
+    template<typename T, typename H, typename E>
+    inline std::pair<ListNode<T>*, bool>
+    IndexedList<T, H, E>::push_back(const T& key)
+    {
+        return push(key, false);
+    }
+
+    template<typename T, typename H, typename E>
+    bool IndexedList<T, H, E>::erase(const T& key)
+    {
+        if (slots_.empty()) return false;
+
+        const auto hole = probe(key, hash_of(key));
+        const auto node = slots_[hole].node, prev = slots_[hole].prev;
+        if (!node) return false;
+
+        if (prev) prev->next = node->next;
+        if (node->next) entry_for(node->next).prev = prev;
+
+        list_ = List<T>{prev ? list_.head() : node->next,
+                        node == list_.tail() ? prev : list_.tail(),
+                        list_.size() - 1u};
+
+        detail::erase_slot(slots_, hole);
+        return true;
+    }
+
+    template<typename T, typename H, typename E>
+    void IndexedList<T, H, E>::rebuild()
+    {
+        list_ = List<T>{list_.head()};
+        slots_.clear();
+        detail::reserve_slots(slots_, list_.size());
+
+        ListNode<T>* prev {};
+        for (auto node = list_.head(); node; prev = node, node = node->next)
+            detail::place_slot(slots_, Entry{hash_of(node->key), node, prev});
+    }
+
+    template<typename T, typename H, typename E>
+    std::size_t
+    IndexedList<T, H, E>::probe(const T& key, const std::size_t h) const
+    {
+        return detail::probe_slot(slots_, h, [&](const Entry& entry) {
+            return key_eq_(entry.node->key, key);
+        });
+    }
+
+    template<typename T, typename H, typename E>
+    auto IndexedList<T, H, E>::entry_for(const ListNode<T>* const node)
+        -> Entry&
+    {
+        return slots_[probe(node->key, hash_of(node->key))];
+    }
+
+    template<typename T, typename H, typename E>
+    std::pair<ListNode<T>*, bool>
+    IndexedList<T, H, E>::push(const T& key, const bool front)
+    {
+        detail::reserve_slots(slots_, list_.size() + 1u);
+
+        const auto h = hash_of(key);
+        const auto i = probe(key, h);
+        if (slots_[i].node) return {slots_[i].node, false};
+
+        const auto node = (*pool_)(key, nullptr);
+        ListNode<T>* prev {};
+
+        if (front) {
+            if (const auto old_head = list_.head())
+                entry_for(old_head).prev = node;
+            list_.push_front(node);
+        } else {
+            prev = list_.tail();
+            list_.push_back(node);
+        }
+
+        slots_[i] = {h, node, prev};
+        return {node, true};
+    }
+
+    template<typename T, typename H, typename E>
+    inline typename IndexedList<T, H, E>::iterator
+    begin(const IndexedList<T, H, E>& list) noexcept
+    {
+        return list.begin();
+    }
+
+    template<typename T, typename H, typename E>
+    inline typename IndexedList<T, H, E>::iterator
+    end(const IndexedList<T, H, E>& list) noexcept
+    {
+        return list.end();
+    }
+}
+
+#endif // ! HAVE_POOL_INDEXEDLIST_HPP_
@@ -0,0 +1,4 @@
+// Intrusive singly linked list hooks and algorithms on intrusive lists.
+// SPDX-License-Identifier: 0BSD
+
+#include "Intrusive.hpp"
@@ -0,0 +1,259 @@
+// Intrusive singly linked list hooks, so existing objects can be linked into
+// lists directly, and algorithms that work on such lists.
+//
+// Copyright (c) 2018 Eliah Kagan
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+// SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+// OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+// CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef HAVE_POOL_INTRUSIVE_HPP_
+#define HAVE_POOL_INTRUSIVE_HPP_
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include "ListNode.hpp"
+
+namespace ek {
+    // A T can be linked into a list by deriving from ListHook<T> or by having
+    // a ListHook<T> data member. Unlike a ListNode<T>, the hook doesn't hold a
+    // copy of the object, and its link points to the next object, not hook.
+    template<typename T>
+    struct ListHook {
+        T* next {};
+    };
+}
+
+// Algorithms on intrusive lists take a hook accessor as an optional template
+// argument: BaseHook<T> (the default) if T derives from ListHook<T>,
+// MemberHook<T, &T::member> if the ListHook<T> is a member of T, or
+// PointerHook<T, &T::member> if the link is a plain T* member of T, as in
+// nodes defined in C.
+namespace ek::intrusive {
+    template<typename T>
+    struct BaseHook {
+        static constexpr T*& next(T& node) noexcept
+        {
+            return static_cast<ListHook<T>&>(node).next;
+        }
+
+        static constexpr T* next(const T& node) noexcept
+        {
+            return static_cast<const ListHook<T>&>(node).next;
+        }
+    };
+
+    template<typename T, ListHook<T> T::*Member>
+    struct MemberHook {
+        static constexpr T*& next(T& node) noexcept
+        {
+            return (node.*Member).next;
+        }
+
+        static constexpr T* next(const T& node) noexcept
+        {
+            return (node.*Member).next;
+        }
+    };
+
+    template<typename T, T* T::*Member>
+    struct PointerHook {
+        static constexpr T*& next(T& node) noexcept
+        {
+            return node.*Member;
+        }
+
+        static constexpr T* next(const T& node) noexcept
+        {
+            return node.*Member;
+        }
+    };
+
+    namespace detail {
+        template<typename H, typename T>
+        using Hook = std::conditional_t<std::is_void_v<H>,
+                                        BaseHook<std::remove_const_t<T>>, H>;
+    }
+
+    // A forward iterator over an intrusive list. Dereferencing gives the
+    // object itself. P is T* or const T*.
+    template<typename P, typename H>
+    class Iterator {
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = std::remove_const_t<std::remove_pointer_t<P>>;
+        using pointer = P;
+        using reference = std::remove_pointer_t<P>&;
+        using iterator_category = std::forward_iterator_tag;
+
+        friend constexpr bool
+        operator==(const Iterator& lhs, const Iterator& rhs) noexcept
+        {
+            return lhs.pos_ == rhs.pos_;
+        }
+
+        friend constexpr bool
+        operator!=(const Iterator& lhs, const Iterator& rhs) noexcept
+        {
+            return lhs.pos_ != rhs.pos_;
+        }
+
+        explicit constexpr Iterator(const P pos = nullptr) noexcept
+            : pos_{pos} { }
+
+        constexpr Iterator& operator++() noexcept
+        {
+            pos_ = H::next(*pos_);
+            return *this;
+        }
+
+        constexpr Iterator operator++(int) noexcept
+        {
+            const auto ret = *this;
+            ++*this;
+            return ret;
+        }
+
+        constexpr reference operator*() const noexcept { return *pos_; }
+
+        constexpr pointer operator->() const noexcept { return pos_; }
+
+    private:
+        P pos_;
+    };
+
+    template<typename H = void, typename T>
+    constexpr Iterator<T*, detail::Hook<H, T>> begin(T* const head) noexcept
+    {
+        return Iterator<T*, detail::Hook<H, T>>{head};
+    }
+
+    template<typename H = void, typename T>
+    constexpr Iterator<T*, detail::Hook<H, T>> end(T*) noexcept
+    {
+        return Iterator<T*, detail::Hook<H, T>>{};
+    }
+
+    template<typename H = void, typename T>
+    bool has_cycle(const T* const head) noexcept
+    {
+        return ek::has_cycle(intrusive::begin<H>(head),
+                             intrusive::end<H>(head));
+    }
+
+    template<typename H = void, typename T, typename F>
+    T* find_if(T* head, F f) noexcept(noexcept(f(*head)))
+    {
+        using Hk = detail::Hook<H, T>;
+
+        while (head && !f(*head)) head = Hk::next(*head);
+        return head;
+    }
+
+    template<typename H = void, typename T>
+    void concat(T* src_head, T* const dest_node) noexcept
+    {
+        using Hk = detail::Hook<H, T>;
+
+        assert(src_head);
+
+        while (Hk::next(*src_head)) src_head = Hk::next(*src_head);
+        Hk::next(*src_head) = dest_node;
+    }
+
+    template<typename H = void, typename T>
+    T* reverse(T* head) noexcept
+    {
+        using Hk = detail::Hook<H, T>;
+
+        T* acc {};
+
+        while (head) {
+            const auto next = Hk::next(*head);
+            Hk::next(*head) = acc;
+            acc = head;
+            head = next;
+        }
+
+        return acc;
+    }
+
+    template<typename H = void, typename T, typename F>
+    std::pair<T*, T*> split(T* head, F f) noexcept(noexcept(f(*head)))
+    {
+        using Hk = detail::Hook<H, T>;
+
+        T* true_head {};
+        T* false_head {};
+        auto true_destp = &true_head, false_destp = &false_head;
+
+        for (; head; head = Hk::next(*head)) {
+            auto& destp = (f(*head) ? true_destp : false_destp);
+            *destp = head;
+            destp = &Hk::next(*head);
+        }
+
+        *true_destp = *false_destp = nullptr;
+        return {true_head, false_head};
+    }
+
+    template<typename H = void, typename T, typename F>
+    T* merge(T* head1, T* head2, F f) noexcept(noexcept(f(*head2, *head1)))
+    {
+        using Hk = detail::Hook<H, T>;
+
+        T* ret {};
+        auto destp = &ret;
+
+        for (; head1 && head2; destp = &Hk::next(**destp)) {
+            auto& src = f(*head2, *head1) ? head2 : head1;
+            *destp = src;
+            src = Hk::next(*src);
+        }
+
+        *destp = (head1 ? head1 : head2);
+        return ret;
+    }
+
+    template<typename H = void, typename T>
+    inline T* merge(T* const head1, T* const head2)
+        noexcept(noexcept(merge<H>(head1, head2, std::less<T>{})))
+    {
+        return merge<H>(head1, head2, std::less<T>{});
+    }
+
+    // A stable bottom-up merge sort that relinks the nodes, taking O(n log n)
+    // time and O(1) space.
+    template<typename H = void, typename T, typename F>
+    T* sort(T* const head, F f) noexcept(noexcept(f(*head, *head)))
+    {
+        using Hk = detail::Hook<H, T>;
+
+        return ek::detail::bin_sort(head,
+                [](T& elem) noexcept -> T*& { return Hk::next(elem); },
+                [&f](T* const head1, T* const head2) {
+                    return merge<H>(head1, head2, f);
+                });
+    }
+
+    template<typename H = void, typename T>
+    inline T* sort(T* const head)
+        noexcept(noexcept(sort<H>(head, std::less<T>{})))
+    {
+        return sort<H>(head, std::less<T>{});
+    }
+}
+
+#endif // ! HAVE_POOL_INTRUSIVE_HPP_
@@ -0,0 +1,4 @@
+// A singly linked list handle that tracks its tail and length.
+// SPDX-License-Identifier: 0BSD
+
+#include "List.hpp"
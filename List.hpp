@@ -0,0 +1,356 @@
+// A singly linked list handle that tracks the tail and length of a ListNode
+// list, so that appending, concatenation, and size queries take O(1) time.
+//
+// Copyright (c) 2018 Eliah Kagan
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+// SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+// OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+// CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef HAVE_POOL_LIST_HPP_
+#define HAVE_POOL_LIST_HPP_
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "ListNode.hpp"
+#include "Pool.hpp"
+
+namespace ek {
+    // Like a ListNode<T>*, a List<T> does not own the nodes it refers to, and
+    // copying it makes another handle to the same nodes. The list must be
+    // acyclic, and changes made to its nodes other than through the List<T>
+    // functions below may make the stored tail and size stale.
+    template<typename T>
+    class List {
+    public:
+        using size_type = std::size_t;
+        using iterator = typename ListNode<T>::iterator;
+        using const_iterator = typename ListNode<T>::const_iterator;
+
+        constexpr List() noexcept = default;
+
+        // Adopts an existing list. This walks it once to find its tail.
+        explicit List(ListNode<T>* head) noexcept;
+
+        constexpr List(ListNode<T>* const head, ListNode<T>* const tail,
+                       const size_type size) noexcept
+            : head_{head}, tail_{tail}, size_{size}
+        {
+            assert(!head == !tail && !head == !size);
+        }
+
+        template<typename I,
+                 typename = std::enable_if_t<std::is_same_v<
+                        typename std::iterator_traits<I>::value_type, T>>>
+        List(Pool<ListNode<T>>& pool, I first, I last);
+
+        // If c is an rvalue, its elements are moved into the nodes.
+        template<typename C,
+                 typename = std::enable_if_t<detail::collects<C, T>>>
+        List(Pool<ListNode<T>>& pool, C&& c);
+
+        List(Pool<ListNode<T>>& pool, std::initializer_list<T> ilist);
+
+        constexpr ListNode<T>* head() const noexcept { return head_; }
+        constexpr ListNode<T>* tail() const noexcept { return tail_; }
+        constexpr size_type size() const noexcept { return size_; }
+        constexpr bool empty() const noexcept { return !head_; }
+
+        constexpr iterator begin() const noexcept { return iterator{head_}; }
+        constexpr iterator end() const noexcept { return iterator{}; }
+
+        constexpr const_iterator cbegin() const noexcept
+        {
+            return const_iterator{head_};
+        }
+
+        constexpr const_iterator cend() const noexcept
+        {
+            return const_iterator{};
+        }
+
+        void push_front(ListNode<T>* node) noexcept;
+        void push_back(ListNode<T>* node) noexcept;
+
+    private:
+        ListNode<T>* head_ {};
+        ListNode<T>* tail_ {};
+        size_type size_ {};
+    };
+
+    template<typename T>
+    List<T>::List(ListNode<T>* const head) noexcept : head_{head}
+    {
+        for (auto cur = head; cur; cur = cur->next) {
+            tail_ = cur;
+            ++size_;
+        }
+    }
+
+    template<typename T>
+    template<typename I, typename>
+    List<T>::List(Pool<ListNode<T>>& pool, I first, const I last)
+    {
+        for (; first != last; ++first) push_back(pool(*first, nullptr));
+    }
+
+    template<typename T>
+    template<typename C, typename>
+    List<T>::List(Pool<ListNode<T>>& pool, C&& c)
+    {
+        using std::begin, std::end;
+
+        for (auto first = begin(c), last = end(c); first != last; ++first) {
+            if constexpr (std::is_lvalue_reference_v<C>)
+                push_back(pool(*first, nullptr));
+            else
+                push_back(pool(std::move(*first), nullptr));
+        }
+    }
+
+    template<typename T>
+    List<T>::List(Pool<ListNode<T>>& pool,
+                  const std::initializer_list<T> ilist)
+        : List{pool, std::cbegin(ilist), std::cend(ilist)}
+    {
+    }
+
+    template<typename T>
+    void List<T>::push_front(ListNode<T>* const node) noexcept
+    {
+        assert(node);
+
+        node->next = head_;
+        head_ = node;
+        if (!tail_) tail_ = node;
+        ++size_;
+    }
+
+    template<typename T>
+    void List<T>::push_back(ListNode<T>* const node) noexcept
+    {
+        assert(node);
+
+        node->next = nullptr;
+        (tail_ ? tail_->next : head_) = node;
+        tail_ = node;
+        ++size_;
+    }
+
+    template<typename T>
+    constexpr typename List<T>::iterator begin(const List<T>& list) noexcept
+    {
+        return list.begin();
+    }
+
+    template<typename T>
+    constexpr typename List<T>::iterator end(const List<T>& list) noexcept
+    {
+        return list.end();
+    }
+
+    template<typename T>
+    constexpr typename List<T>::const_iterator
+    cbegin(const List<T>& list) noexcept
+    {
+        return list.cbegin();
+    }
+
+    template<typename T>
+    constexpr typename List<T>::const_iterator
+    cend(const List<T>& list) noexcept
+    {
+        return list.cend();
+    }
+
+    template<typename T>
+    inline std::ostream& operator<<(std::ostream& out, const List<T>& list)
+    {
+        return out << detail::be_const(list.head());
+    }
+
+    template<typename T>
+    inline std::vector<T> vec(const List<T>& list)
+    {
+        std::vector<T> ret;
+        ret.reserve(list.size());
+        ret.assign(cbegin(list), cend(list));
+        return ret;
+    }
+
+    template<typename T>
+    List<T> clone(Pool<ListNode<T>>& pool, const List<T>& list)
+    {
+        List<T> ret;
+        for (const auto& key : list) ret.push_back(pool(key, nullptr));
+        return ret;
+    }
+
+    // Appends the nodes of src to dest in O(1) time. Like the ListNode<T>*
+    // version, this does not copy, so src is afterwards a suffix of dest.
+    template<typename T>
+    void concat(List<T>& dest, const List<T>& src) noexcept
+    {
+        if (src.empty()) return;
+
+        if (dest.empty()) {
+            dest = src;
+        } else {
+            dest.tail()->next = src.head();
+            dest = List<T>{dest.head(), src.tail(), dest.size() + src.size()};
+        }
+    }
+
+    // Sizes are known, so the longer list is cropped without counting nodes.
+    // Lists with different tails cannot meet, so that case is O(1).
+    template<typename T>
+    ListNode<T>* meet_node(const List<T>& list1, const List<T>& list2) noexcept
+    {
+        if (list1.tail() != list2.tail()) return nullptr;
+
+        auto head1 = list1.head(), head2 = list2.head();
+        auto size1 = list1.size(), size2 = list2.size();
+
+        for (; size1 > size2; --size1) head1 = head1->next;
+        for (; size2 > size1; --size2) head2 = head2->next;
+
+        while (head1 != head2) {
+            head1 = head1->next;
+            head2 = head2->next;
+        }
+
+        return head1;
+    }
+
+    template<typename T>
+    inline typename List<T>::iterator
+    meet(const List<T>& list1, const List<T>& list2) noexcept
+    {
+        return typename List<T>::iterator{meet_node(list1, list2)};
+    }
+
+    template<typename T, typename U>
+    inline bool equal(const List<T>& list1, const List<U>& list2)
+        noexcept(noexcept(equal(detail::be_const(list1.head()),
+                                detail::be_const(list2.head()))))
+    {
+        return list1.size() == list2.size()
+                && equal(detail::be_const(list1.head()),
+                         detail::be_const(list2.head()));
+    }
+
+    template<typename T, typename U, typename F>
+    inline bool equal(const List<T>& list1, const List<U>& list2, const F f)
+        noexcept(noexcept(equal(detail::be_const(list1.head()),
+                                detail::be_const(list2.head()), f)))
+    {
+        return list1.size() == list2.size()
+                && equal(detail::be_const(list1.head()),
+                         detail::be_const(list2.head()), f);
+    }
+
+    template<typename T>
+    inline List<T> reverse(const List<T>& list) noexcept
+    {
+        const auto tail = list.head();
+        return List<T>{reverse(list.head()), tail, list.size()};
+    }
+
+    template<typename T, typename F>
+    std::pair<List<T>, List<T>> split(const List<T>& list, F f)
+        noexcept(noexcept(f(list.head()->key)))
+    {
+        List<T> true_list, false_list;
+
+        for (auto head = list.head(); head; ) {
+            const auto next = head->next;
+            (f(head->key) ? true_list : false_list).push_back(head);
+            head = next;
+        }
+
+        return {true_list, false_list};
+    }
+
+    // Both lists must be sorted, so the merged list ends with whichever tail
+    // merge would take last. (On ties, merge takes from the first list.)
+    template<typename T, typename F>
+    List<T> merge(const List<T>& list1, const List<T>& list2, F f)
+        noexcept(noexcept(f(list2.head()->key, list1.head()->key)))
+    {
+        if (list1.empty()) return list2;
+        if (list2.empty()) return list1;
+
+        const auto tail = (f(list2.tail()->key, list1.tail()->key)
+                            ? list1.tail()
+                            : list2.tail());
+
+        return List<T>{merge(list1.head(), list2.head(), f), tail,
+                       list1.size() + list2.size()};
+    }
+
+    template<typename T>
+    inline List<T> merge(const List<T>& list1, const List<T>& list2)
+        noexcept(noexcept(merge(list1, list2, std::less{})))
+    {
+        return merge(list1, list2, std::less{});
+    }
+
+    template<typename T, typename F>
+    List<T> drop_min(const List<T>& list, F f)
+    {
+        if (list.empty())
+            throw std::invalid_argument{"empty list has no minimal element"};
+
+        auto head = list.head(), best = head;
+        ListNode<T>* best_prev {};
+
+        for (auto prev = head; prev->next; prev = prev->next) {
+            if (f(prev->next->key, best->key)) {
+                best_prev = prev;
+                best = prev->next;
+            }
+        }
+
+        (best_prev ? best_prev->next : head) = best->next;
+
+        return List<T>{head, (best == list.tail() ? best_prev : list.tail()),
+                       list.size() - 1u};
+    }
+
+    template<typename T>
+    inline List<T> drop_min(const List<T>& list)
+    {
+        return drop_min(list, std::less{});
+    }
+
+    template<typename T, typename F>
+    inline List<T> drop_max(const List<T>& list, F f)
+    {
+        return drop_min(list, [f](const auto& x, const auto& y) {
+            return f(y, x);
+        });
+    }
+
+    template<typename T>
+    inline List<T> drop_max(const List<T>& list)
+    {
+        return drop_min(list, std::greater{});
+    }
+}
+
+#endif // ! HAVE_POOL_LIST_HPP_
@@ -15,29 +15,47 @@
 
 #include "ListNode-test.hpp"
 
+#include "BatchFind.hpp"
+#include "BloomFilter.hpp"
+#include "CList.hpp"
+#include "CompressedList.hpp"
+#include "ExternalSort.hpp"
+#include "HashCons.hpp"
+#include "IndexedList.hpp"
+#include "Intrusive.hpp"
+#include "List.hpp"
 #include "ListNode.hpp"
+#include "LruCache.hpp"
+#include "MeetIndex.hpp"
 #include "NoDefault.hpp"
 #include "P.hpp"
 #include "Pool.hpp"
+#include "View.hpp"
+#include "list_node.h"
 
+#include <algorithm>
 #include <bitset>
 #include <cassert>
 #include <functional>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <memory>
 #include <numeric>
+#include <random>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 namespace {
     using namespace std::literals;
     using namespace ek::literals;
-    using ek::ListNode, ek::NoDefault, ek::P, ek::Pool;
+    using ek::List, ek::ListNode, ek::NoDefault, ek::P, ek::Pool;
 
     template<typename... Ts>
     bool acyclic(const ListNode<Ts>* const... heads)
@@ -158,6 +176,63 @@ namespace {
             std::cout << p->first << ' ' << p->second << '\n';
     }
 
+    void test_emplace()
+    {
+        // A key that can be neither copied nor moved, built from two parts.
+        struct Pinned {
+            Pinned(const int first, const int second) noexcept
+                : value{first * 10 + second} { }
+
+            Pinned(const Pinned&) = delete;
+            Pinned& operator=(const Pinned&) = delete;
+
+            int value;
+        };
+
+        Pool<ListNode<Pinned>> pool;
+        const auto tail = pool(std::in_place, nullptr, 3, 4);
+        const auto head = pool(std::in_place, tail, 1, 2);
+        assert(head->key.value == 12 && head->next->key.value == 34);
+
+        // Aggregates are built from their members.
+        struct Point {
+            int x;
+            int y;
+        };
+
+        Pool<ListNode<Point>> points;
+        const auto p = points(std::in_place, nullptr, 5, 6);
+        assert(p->key.x == 5 && p->key.y == 6);
+
+        // Elements of rvalue ranges are moved, so move-only keys work.
+        using Up = std::unique_ptr<int>;
+        Pool<ListNode<Up>> ups;
+
+        std::vector<Up> v;
+        for (auto i = 0; i != 4; ++i) v.push_back(std::make_unique<int>(i));
+
+        const auto moved = make_list(ups, std::move(v));
+        auto sum = 0, count = 0;
+        for (const auto& up : moved) {
+            sum += *up;
+            ++count;
+        }
+        assert(sum == 6 && count == 4);
+
+        std::vector<Up> w;
+        w.push_back(std::make_unique<int>(7));
+        const List<Up> list {ups, std::move(w)};
+        assert(list.size() == 1u && *list.head()->key == 7);
+
+        // Lvalue ranges are still copied.
+        std::vector<std::string> words {"alpha", "beta"};
+        Pool<ListNode<std::string>> strs;
+        const auto copied = make_list(strs, words);
+        assert(vec(copied) == words && words.front() == "alpha");
+
+        std::cout << make_list(strs, std::move(words)) << '\n';
+    }
+
     void test_print()
     {
         Pool<ListNode<std::string_view>> pool;
@@ -202,6 +277,40 @@ namespace {
         cyc();
     }
 
+    void test_find_cycle()
+    {
+        Pool<ListNode<int>> pool;
+
+        // Makes a list of tail + cycle nodes whose last node (if the cycle is
+        // nonempty) links back to the node at index tail.
+        const auto rho = [&pool](const int tail, const int cycle) {
+            std::vector<int> v (static_cast<std::size_t>(tail + cycle));
+            std::iota(begin(v), end(v), 0);
+            const auto head = make_list(pool, v);
+            if (cycle != 0) concat(head, find(head, tail));
+            return head;
+        };
+
+        std::cout << '\n';
+
+        for (auto tail = 0; tail != 12; ++tail) {
+            for (auto cycle = 0; cycle != 12; ++cycle) {
+                const auto head = rho(tail, cycle);
+                const auto [entry, mu, lambda] = find_cycle(head);
+
+                assert(has_cycle(head) == (cycle != 0));
+                assert(mu == static_cast<std::size_t>(tail));
+                assert(lambda == static_cast<std::size_t>(cycle));
+                assert(cycle == 0 ? !entry : entry && entry->key == tail);
+            }
+        }
+
+        const ListNode<int>* const chead = rho(3, 7);
+        const auto [centry, cmu, clambda] = find_cycle(chead);
+        std::cout << "Cycle entry " << centry->key << ", tail length " << cmu
+                  << ", cycle length " << clambda << '\n';
+    }
+
     void test_copy()
     {
         Pool<ListNode<std::string>> pool;
@@ -218,6 +327,37 @@ namespace {
             std::cout << '|' << *p << ' ' << *q << '\n';
     }
 
+    void test_clone()
+    {
+        Pool<ListNode<int>> scratch;
+        std::vector<ListNode<int>*> nodes;
+        for (auto i = 0; i != 100; ++i) nodes.push_back(scratch(i, nullptr));
+
+        std::shuffle(begin(nodes), end(nodes), std::mt19937{3u});
+        for (auto i = std::size_t{1u}; i != nodes.size(); ++i)
+            nodes[i - 1u]->next = nodes[i];
+
+        Pool<ListNode<int>> pool;
+        const auto head = clone(pool, nodes.front());
+        assert(equal(head, nodes.front()) && pool.size() == nodes.size());
+
+        // The copy is in list order in its pool, and shares no nodes.
+        auto slot = std::size_t{0u};
+        for (auto node = head; node; node = node->next)
+            assert(node == &pool[slot++]);
+
+        head->key = -1;
+        assert(nodes.front()->key != -1);
+
+        const List<int> list {nodes.front()};
+        const auto copy = clone(pool, list);
+        assert(equal(copy, list) && copy.head() != list.head());
+        assert(copy.tail() == &pool[pool.size() - 1u]);
+
+        assert(!clone(pool, static_cast<ListNode<int>*>(nullptr)));
+        assert(clone(pool, List<int>{}).empty());
+    }
+
     void test_find()
     {
         Pool<ListNode<std::string_view>> pool;
@@ -287,6 +427,39 @@ namespace {
         //const auto head4c = find_node(head1c, "baz");
     }
 
+    void test_self_organizing()
+    {
+        Pool<ListNode<char>> pool;
+
+        auto head = make_list(pool, {'a', 'b', 'c', 'd', 'e'});
+        const auto d = ek::find_mtf(head, 'd');
+        assert(d == head && d->key == 'd');
+        assert(vec(head) == (std::vector{'d', 'a', 'b', 'c', 'e'}));
+
+        assert(ek::find_mtf(head, 'd') == d);
+        assert(!ek::find_mtf(head, 'z'));
+        ek::find_mtf(head, 'e');
+        assert(vec(head) == (std::vector{'e', 'd', 'a', 'b', 'c'}));
+
+        assert(ek::find_transpose(head, 'b')->key == 'b');
+        assert(vec(head) == (std::vector{'e', 'd', 'b', 'a', 'c'}));
+        ek::find_transpose(head, 'd');
+        assert(vec(head) == (std::vector{'d', 'e', 'b', 'a', 'c'}));
+        ek::find_transpose(head, 'd');
+        assert(vec(head) == (std::vector{'d', 'e', 'b', 'a', 'c'}));
+        assert(!ek::find_transpose(head, 'z'));
+
+        const auto vowel = ek::find_if_transpose(head, [](const char c) {
+            return c == 'a' || c == 'e';
+        });
+        assert(vowel->key == 'e');
+        assert(vec(head) == (std::vector{'e', 'd', 'b', 'a', 'c'}));
+
+        ListNode<char>* empty {};
+        assert(!ek::find_mtf(empty, 'a') && !ek::find_transpose(empty, 'a'));
+        std::cout << "After self-organizing lookups: " << head << '\n';
+    }
+
     void test_equal()
     {
         Pool<ListNode<int>> pi;
@@ -461,6 +634,389 @@ namespace {
         std::cout << h2 << '\n';
     }
 
+    void test_split_n()
+    {
+        Pool<ListNode<int>> pool;
+
+        std::vector<int> a (50);
+        std::iota(begin(a), end(a), 0);
+
+        constexpr auto mod5 = [](const int x) { return x % 5; };
+
+        const auto fixed = ek::split_n<5>(make_list(pool, a), mod5);
+        const auto dynamic = split_n(make_list(pool, a), 5u, mod5);
+        assert(dynamic.size() == 5u);
+
+        for (std::size_t i = 0u; i != 5u; ++i) {
+            std::vector<int> expected;
+            std::copy_if(cbegin(a), cend(a), back_inserter(expected),
+                         [i](const int x) {
+                return static_cast<std::size_t>(x % 5) == i;
+            });
+
+            assert(vec(fixed[i]) == expected && vec(dynamic[i]) == expected);
+        }
+
+        const auto tens = ek::split_n<3>(make_list(pool, 1, 2, 10, 11, 20),
+                                         [](const int x) { return x / 10; });
+
+        std::cout << '\n';
+        for (const auto head : tens) std::cout << head << '\n';
+
+        const auto none = split_n(make_list(pool, {}), 4u, mod5);
+        assert(std::all_of(cbegin(none), cend(none),
+                           [](const ListNode<int>* const head) {
+            return !head;
+        }));
+        // Caller-provided storage, so nothing is allocated.
+        ListNode<int>* heads[5];
+        ListNode<int>** tails[5];
+        split_n(make_list(pool, a), std::begin(heads), std::end(heads),
+                std::begin(tails), mod5);
+        for (std::size_t i = 0u; i != 5u; ++i)
+            assert(vec(heads[i]) == vec(fixed[i]));
+
+        auto threw = false;
+        try {
+            split_n(make_list(pool, 1, 2), 0u, mod5);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        assert(threw);
+
+        threw = false;
+        const auto bad = make_list(pool, 0, 1, 8, 2), rest = bad->next->next;
+        try {
+            split_n(bad, std::begin(heads), std::begin(heads) + 3,
+                    std::begin(tails), mod5);
+        } catch (const std::out_of_range&) {
+            threw = true;
+        }
+        assert(threw);
+        assert(vec(heads[0]) == std::vector{0});
+        assert(vec(heads[1]) == std::vector{1} && !heads[2]);
+        assert(vec(rest) == (std::vector{8, 2}));
+    }
+
+    void test_merge_adaptive()
+    {
+        using std::pair;
+
+        std::mt19937 gen {12345u};
+
+        Pool<ListNode<pair<int, int>>> pool;
+
+        constexpr auto by_first = [](const auto& lhs, const auto& rhs) {
+            return lhs.first < rhs.first;
+        };
+
+        // Runs of random lengths (long and short) with keys from few values.
+        const auto make_sorted = [&](const int tag) {
+            std::uniform_int_distribution<> len {0, 300}, key {0, 40};
+            std::vector<pair<int, int>> v (static_cast<std::size_t>(len(gen)));
+            for (auto& [k, t] : v) std::tie(k, t) = pair{key(gen), tag};
+            std::stable_sort(begin(v), end(v), by_first);
+            return v;
+        };
+
+        for (auto trial = 0; trial != 200; ++trial) {
+            const auto a = make_sorted(1), b = make_sorted(2);
+
+            std::vector<pair<int, int>> expected;
+            std::merge(cbegin(a), cend(a), cbegin(b), cend(b),
+                       back_inserter(expected), by_first);
+
+            const auto head = merge(make_list(pool, a), make_list(pool, b),
+                                    by_first);
+            assert(vec(head) == expected);
+        }
+
+        Pool<ListNode<int>> pi;
+
+        std::vector<int> low (1000), high (1000);
+        std::iota(begin(low), end(low), 0);
+        std::iota(begin(high), end(high), 1000);
+
+        auto count = 0;
+        const auto counting_less = [&count](const int lhs, const int rhs) {
+            ++count;
+            return lhs < rhs;
+        };
+
+        const auto head = merge(make_list(pi, high), make_list(pi, low),
+                                counting_less);
+        assert(std::is_sorted(cbegin(head), cend(head)));
+        assert(std::distance(cbegin(head), cend(head)) == 2000);
+        std::cout << '\n' << "Comparisons to merge disjoint ranges: "
+                  << count << '\n';
+        assert(count < 100);
+    }
+
+    void test_set_algebra()
+    {
+        std::mt19937 gen {12345u};
+        Pool<ListNode<int>> pool;
+
+        const auto make_sorted = [&] {
+            std::uniform_int_distribution<> len {0, 200}, key {0, 60};
+            std::vector<int> v (static_cast<std::size_t>(len(gen)));
+            for (auto& x : v) x = key(gen);
+            std::sort(begin(v), end(v));
+            return v;
+        };
+
+        for (auto trial = 0; trial != 100; ++trial) {
+            const auto a = make_sorted(), b = make_sorted();
+
+            const auto check = [&](const auto list_op, const auto std_op) {
+                std::vector<int> expected;
+                std_op(cbegin(a), cend(a), cbegin(b), cend(b),
+                       back_inserter(expected));
+
+                const auto head = list_op(make_list(pool, a),
+                                          make_list(pool, b));
+                assert(vec(head) == expected);
+            };
+
+            check([](auto h1, auto h2) { return ek::set_union(h1, h2); },
+                  [](auto... args) { return std::set_union(args...); });
+            check([](auto h1, auto h2) { return ek::set_intersection(h1, h2); },
+                  [](auto... args) { return std::set_intersection(args...); });
+            check([](auto h1, auto h2) { return ek::set_difference(h1, h2); },
+                  [](auto... args) { return std::set_difference(args...); });
+            check([](auto h1, auto h2) {
+                      return ek::set_symmetric_difference(h1, h2);
+                  },
+                  [](auto... args) {
+                      return std::set_symmetric_difference(args...);
+                  });
+        }
+
+        // Ties take the first list's nodes.
+        const auto x = make_list(pool, {1, 2, 3}), y = make_list(pool, {2, 4});
+        const auto both = ek::set_union(x, y);
+        assert(vec(both) == (std::vector{1, 2, 3, 4}));
+        assert(both->next == x->next);
+
+        // A short list against a long one takes few comparisons.
+        std::vector<int> evens (100'000);
+        for (auto i = 0; i != 100'000; ++i)
+            evens[static_cast<std::size_t>(i)] = i * 2;
+
+        auto count = 0;
+        const auto counting_less = [&count](const int lhs, const int rhs) {
+            ++count;
+            return lhs < rhs;
+        };
+
+        const auto found = ek::set_intersection(
+                make_list(pool, {3, 50'000, 120'001, 199'998}),
+                make_list(pool, evens), counting_less);
+        assert(vec(found) == (std::vector{50'000, 199'998}));
+
+        std::cout << '\n' << "Comparisons to intersect 4 with 100000 nodes: "
+                  << count << '\n';
+        assert(count < 200);
+    }
+
+    void test_merge_k()
+    {
+        using std::pair;
+
+        Pool<ListNode<pair<int, char>>> pool;
+
+        std::vector<ListNode<pair<int, char>>*> runs {
+            make_list(pool, {pair{1, 'a'}, pair{4, 'a'}, pair{4, 'b'}}),
+            nullptr,
+            make_list(pool, {pair{2, 'c'}, pair{4, 'c'}, pair{9, 'c'}}),
+            make_list(pool, {pair{0, 'd'}, pair{4, 'd'}}),
+            make_list(pool, {pair{3, 'e'}}),
+        };
+
+        std::vector<pair<int, char>> expected;
+        for (const auto head : runs)
+            std::copy(cbegin(head), cend(head), back_inserter(expected));
+
+        constexpr auto by_first = [](const auto& lhs, const auto& rhs) {
+            return lhs.first < rhs.first;
+        };
+
+        std::stable_sort(begin(expected), end(expected), by_first);
+
+        const auto head = merge_k(cbegin(runs), cend(runs), by_first);
+        assert(vec(head) == expected && acyclic(head));
+
+        std::cout << '\n';
+        for (const auto& [x, c] : head) std::cout << x << c << ' ';
+        std::cout << '\n';
+
+        Pool<ListNode<int>> pi;
+
+        std::vector<ListNode<int>*> none;
+        assert(!merge_k(cbegin(none), cend(none)));
+
+        std::vector<ListNode<int>*> many;
+        for (auto i = 0; i != 37; ++i)
+            many.push_back(make_list(pi, {i, i + 37, i + 74}));
+
+        const auto got = vec(merge_k(cbegin(many), cend(many)));
+        std::vector<int> all (got.size());
+        std::iota(begin(all), end(all), 0);
+        assert(got == all && got.size() == 111u);
+
+        const std::vector one {make_list(pi, 5, 10, 15)};
+        std::cout << merge_k(cbegin(one), cend(one), std::greater{}) << '\n';
+    }
+
+    void test_sort()
+    {
+        using std::pair;
+
+        Pool<ListNode<pair<int, int>>> pool;
+
+        std::mt19937 gen {47u};
+        std::uniform_int_distribution<int> dist {0, 99};
+
+        std::vector<pair<int, int>> keys;
+        for (auto i = 0; i != 1000; ++i) keys.emplace_back(dist(gen), i);
+
+        constexpr auto by_first = [](const auto& lhs, const auto& rhs) {
+            return lhs.first < rhs.first;
+        };
+
+        const auto head = sort(make_list(pool, keys), by_first);
+
+        std::stable_sort(begin(keys), end(keys), by_first);
+        assert(vec(head) == keys && acyclic(head));
+
+        Pool<ListNode<int>> pi;
+        assert(!sort(static_cast<ListNode<int>*>(nullptr)));
+        std::cout << sort(make_list(pi, 3, 1, 4, 1, 5, 9, 2, 6)) << '\n';
+    }
+
+    void test_external_sort()
+    {
+        std::mt19937 gen {48u};
+
+        // Enough records for a 64 KiB budget to need more than one pass.
+        std::vector<int> keys (100'000);
+        for (auto& key : keys) key = static_cast<int>(gen());
+
+        const auto sorted = [](const std::string& bytes, auto record) {
+            std::vector<decltype(record)> ret (bytes.size() / sizeof record);
+            std::copy_n(bytes.data(), bytes.size(),
+                        reinterpret_cast<char*>(ret.data()));
+            return ret;
+        };
+
+        std::stringstream in {std::ios::in | std::ios::out
+                                | std::ios::binary};
+        in.write(reinterpret_cast<const char*>(keys.data()),
+                 static_cast<std::streamsize>(keys.size() * sizeof(int)));
+
+        std::stringstream out {std::ios::in | std::ios::out
+                                | std::ios::binary};
+        ek::external_sort<int>(in, out, 64u * 1024u);
+
+        std::sort(begin(keys), end(keys));
+        assert(sorted(out.str(), 0) == keys);
+
+        // Ties keep their input order, across runs and merge passes.
+        struct Record {
+            int key;
+            int seq;
+        };
+
+        std::vector<Record> records (30'000);
+        for (auto i = std::size_t{0u}; i != records.size(); ++i) {
+            records[i] = {static_cast<int>(gen() % 50u),
+                          static_cast<int>(i)};
+        }
+
+        std::stringstream rin {std::ios::in | std::ios::out
+                                | std::ios::binary};
+        rin.write(reinterpret_cast<const char*>(records.data()),
+                  static_cast<std::streamsize>(records.size()
+                                                * sizeof(Record)));
+
+        std::stringstream rout {std::ios::in | std::ios::out
+                                | std::ios::binary};
+        ek::external_sort<Record>(rin, rout, 16u * 1024u,
+                              [](const Record& lhs, const Record& rhs) {
+            return lhs.key < rhs.key;
+        });
+
+        const auto got = sorted(rout.str(), Record{});
+        assert(got.size() == records.size());
+        for (std::size_t i = 1u; i < got.size(); ++i) {
+            assert(got[i - 1u].key <= got[i].key);
+            if (got[i - 1u].key == got[i].key)
+                assert(got[i - 1u].seq < got[i].seq);
+        }
+
+        // Small inputs are sorted in memory, and empty input gives no output.
+        std::stringstream small_in {"\3\1\2"s};
+        std::stringstream small_out;
+        ek::external_sort<char>(small_in, small_out, 1024u, std::greater{});
+        assert(small_out.str() == "\3\2\1"s);
+
+        std::stringstream empty_in, empty_out;
+        ek::external_sort<int>(empty_in, empty_out, 1024u);
+        assert(empty_out.str().empty());
+
+        std::stringstream partial {"abcde"s};
+        auto threw = false;
+        try {
+            ek::external_sort<int>(partial, empty_out, 1024u);
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw);
+
+        std::cout << "external sort: " << got.size() << " records\n";
+    }
+
+    void test_find_nodes()
+    {
+        Pool<ListNode<int>> pool;
+        std::mt19937 gen {50u};
+
+        // Lists of different lengths, and a key for each, often missing.
+        std::vector<ListNode<int>*> heads;
+        std::vector<int> keys;
+
+        for (auto i = 0; i != 300; ++i) {
+            std::vector<int> list_keys (gen() % 40u);
+            for (auto& key : list_keys) key = static_cast<int>(gen() % 50u);
+
+            heads.push_back(make_list(pool, list_keys));
+            keys.push_back(static_cast<int>(gen() % 60u));
+        }
+
+        for (const std::size_t group : {1u, 3u, 16u, 1000u}) {
+            const auto found = ek::find_nodes(cbegin(heads), cend(heads),
+                                              cbegin(keys), group);
+
+            assert(found.size() == heads.size());
+            for (auto i = std::size_t{0u}; i != heads.size(); ++i)
+                assert(found[i] == find_node(heads[i], keys[i]));
+        }
+
+        // Many keys in one list, through const nodes.
+        const ListNode<int>* const head = make_list(pool, 5, 8, 2, 8, 9);
+        const std::vector<const ListNode<int>*> same (4u, head);
+        const std::vector probes {8, 9, 1, 5};
+
+        const auto found = ek::find_nodes(cbegin(same), cend(same),
+                                          cbegin(probes));
+        const auto last = head->next->next->next->next;
+        assert(found[0] == head->next && found[1] == last);
+        assert(!found[2] && found[3] == head);
+
+        assert(ek::find_nodes(cbegin(same), cbegin(same),
+                              cbegin(probes)).empty());
+    }
+
     void test_meet()
     {
         constexpr auto sp = "   ";
@@ -504,6 +1060,69 @@ namespace {
                   << meet_node(ce, h2) << sp << meet_node(h2, ce) << '\n';
     }
 
+    void test_meet_index()
+    {
+        Pool<ListNode<int>> pool;
+        std::mt19937 gen {11u};
+
+        // Each new list has a few nodes of its own, then either ends or
+        // joins some node of an earlier list.
+        std::vector<ListNode<int>*> heads;
+        std::vector<ListNode<int>*> all;
+
+        for (auto i = 0; i != 300; ++i) {
+            ListNode<int>* join {};
+            if (!all.empty() && gen() % 8u != 0u)
+                join = all[gen() % all.size()];
+
+            auto head = join;
+            for (auto own = gen() % 4u; own != 0u; --own) {
+                head = pool(i, head);
+                all.push_back(head);
+            }
+
+            heads.push_back(head);
+        }
+
+        heads.push_back(nullptr);
+        heads.push_back(heads[5]);
+
+        const ek::MeetIndex<int> index (cbegin(heads), cend(heads));
+        assert(index.size() == heads.size());
+
+        auto meets = 0;
+        for (auto i = std::size_t{0u}; i != heads.size(); ++i) {
+            for (auto j = std::size_t{0u}; j != heads.size(); ++j) {
+                const auto expected = meet_node(heads[i], heads[j]);
+                assert(index.meet_node(i, j) == expected);
+                assert(index.meet(i, j) == meet(heads[i], heads[j]));
+                if (i < j && expected) ++meets;
+            }
+        }
+
+        auto reported = 0;
+        index.for_each_meet([&](const std::size_t i, const std::size_t j,
+                                const ListNode<int>* const node) {
+            assert(i < j && node == meet_node(heads[i], heads[j]));
+            ++reported;
+        });
+        assert(reported == meets);
+
+        std::cout << "meet index of " << heads.size() << " lists found "
+                  << meets << " meeting pairs\n";
+
+        auto cycle = make_list(pool, {1, 2, 3});
+        cycle->next->next->next = cycle->next;
+
+        auto threw = false;
+        try {
+            ek::MeetIndex<int> bad {heads[0], cycle};
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+
     void test_meet_structural()
     {
         Pool<ListNode<char>> pool;
@@ -555,6 +1174,685 @@ namespace {
             std::cerr << "error: " << e.what() << '\n';
         }
     }
+
+    struct Order : ek::ListHook<Order> {
+        Order(const int _id, const int _price) : id{_id}, price{_price} { }
+
+        Order(const Order&) = delete;
+        Order& operator=(const Order&) = delete;
+
+        int id;
+        int price;
+    };
+
+    struct Item {
+        std::string name;
+        ek::ListHook<Item> by_name;
+        ek::ListHook<Item> by_size;
+    };
+
+    void test_intrusive()
+    {
+        namespace in = ek::intrusive;
+
+        Order orders[] {{1, 30}, {2, 10}, {3, 40}, {4, 20}, {5, 50}};
+
+        Order* head {};
+        for (auto& order : orders) { // Link in reverse order, then fix that.
+            order.next = head;
+            head = &order;
+        }
+        head = in::reverse(head);
+        assert(!in::has_cycle(head) && head == &orders[0]);
+
+        const auto ids = [](const Order* p) {
+            std::vector<int> ret;
+            for (; p; p = p->next) ret.push_back(p->id);
+            return ret;
+        };
+
+        const auto found = in::find_if(head, [](const Order& order) {
+            return order.price > 35;
+        });
+        assert(found == &orders[2]);
+
+        auto [cheap, dear] = in::split(head, [](const Order& order) {
+            return order.price < 25;
+        });
+        assert(ids(cheap) == (std::vector{2, 4}));
+        assert(ids(dear) == (std::vector{1, 3, 5}));
+
+        head = in::merge(cheap, dear, [](const Order& lhs, const Order& rhs) {
+            return lhs.price < rhs.price;
+        });
+        assert(ids(head) == (std::vector{2, 4, 1, 3, 5}));
+
+        std::cout << '\n';
+        for (auto p = in::begin(head); p != in::end(head); ++p)
+            std::cout << p->id << ':' << p->price << ' ';
+        std::cout << '\n';
+
+        in::concat(head, &orders[0]);
+        assert(in::has_cycle(head));
+
+        using ByName = in::MemberHook<Item, &Item::by_name>;
+        using BySize = in::MemberHook<Item, &Item::by_size>;
+
+        Item items[] {{"pear", {}, {}}, {"fig", {}, {}}, {"banana", {}, {}}};
+
+        Item* names {};
+        Item* sizes {};
+        for (auto& item : items) {
+            names = in::merge<ByName>(names, &item,
+                                      [](const Item& lhs, const Item& rhs) {
+                return lhs.name < rhs.name;
+            });
+            sizes = in::merge<BySize>(sizes, &item,
+                                      [](const Item& lhs, const Item& rhs) {
+                return size(lhs.name) < size(rhs.name);
+            });
+        }
+
+        assert(!in::has_cycle<ByName>(names) && !in::has_cycle<BySize>(sizes));
+
+        const auto print = [](const auto first, const auto last) {
+            for (auto p = first; p != last; ++p) std::cout << p->name << ' ';
+            std::cout << '\n';
+        };
+
+        print(in::begin<ByName>(names), in::end<ByName>(names));
+        print(in::begin<BySize>(sizes), in::end<BySize>(sizes));
+
+        assert(std::find_if(in::begin<ByName>(names), in::end<ByName>(names),
+                            [](const Item& item) {
+                                return item.name == "fig";
+                            })->name == "fig");
+
+        // Sorting is stable, so "pear" stays ahead of "banana".
+        sizes = in::sort<BySize>(sizes, [](const Item& lhs, const Item& rhs) {
+            return size(lhs.name) % 2u < size(rhs.name) % 2u;
+        });
+        print(in::begin<BySize>(sizes), in::end<BySize>(sizes));
+        assert(sizes == &items[0] && items[0].by_size.next == &items[2]
+                && items[2].by_size.next == &items[1]);
+    }
+
+    void test_c_list()
+    {
+        namespace cl = ek::clist;
+
+        auto head = list_create(8, 5, 3, 8, 1, 9, 2, 7, 3);
+        const auto first = head;
+
+        head = cl::sort(head);
+        assert(cl::vec(head) == (std::vector{1, 2, 3, 3, 5, 7, 8, 9}));
+        assert(!cl::has_cycle(head) && list_length(head) == 8);
+
+        head = cl::reverse(head);
+        assert(cl::vec(head) == (std::vector{9, 8, 7, 5, 3, 3, 2, 1}));
+        assert(cl::find_if(head, [](const int key) { return key < 5; })->key
+                == 3);
+
+        auto [odd, even] = cl::split(head, [](const int key) {
+            return key % 2 != 0;
+        });
+        assert(cl::vec(even) == (std::vector{8, 2}));
+
+        head = cl::merge(cl::sort(odd), cl::sort(even));
+        assert(cl::vec(head) == (std::vector{1, 2, 3, 3, 5, 7, 8, 9}));
+
+        // The C functions see the same nodes, relinked in place.
+        auto found = false;
+        for (auto p = cl::begin(head); p != cl::end(head); ++p)
+            if (&*p == first) found = true;
+        assert(found && list_sum(head) == 38);
+
+        head = cl::sort(head, std::greater<int>{});
+        std::cout << "C list sorted in place: ";
+        list_print(head);
+
+        list_destroy(head);
+
+        std::mt19937 gen {7u};
+        std::vector<int> keys (1'000);
+        head = nullptr;
+        for (auto& key : keys) {
+            key = static_cast<int>(gen() % 100u);
+            head = list_prepend(head, 1, key);
+        }
+
+        std::sort(begin(keys), end(keys));
+        head = cl::sort(head);
+        assert(cl::vec(head) == keys && !cl::has_cycle(head));
+
+        list_destroy(head);
+    }
+
+    void test_compressed_list()
+    {
+        using ek::CompressedList;
+
+        // Checks every query against the uncompressed keys.
+        const auto check = [](const auto& keys, const auto& packed) {
+            using T = typename std::decay_t<decltype(keys)>::value_type;
+
+            assert(packed.size() == keys.size() && vec(packed) == keys);
+            for (auto i = std::size_t{0u}; i != keys.size(); ++i)
+                assert(packed[i] == keys[i]);
+
+            const auto sum = std::accumulate(
+                    cbegin(keys), cend(keys),
+                    typename CompressedList<T>::sum_type{});
+            assert(packed.sum() == sum);
+
+            if (keys.empty()) return;
+
+            assert(packed.min() == *std::min_element(cbegin(keys), cend(keys)));
+            assert(packed.max() == *std::max_element(cbegin(keys), cend(keys)));
+
+            const auto mid = keys[keys.size() / 2u];
+            for (const auto x : {keys.front(), keys.back(), mid,
+                                 static_cast<T>(keys.back() ^ 1)}) {
+                assert(packed.count(x)
+                        == static_cast<std::size_t>(
+                                std::count(cbegin(keys), cend(keys), x)));
+
+                const auto pos = std::find(cbegin(keys), cend(keys), x);
+                assert(packed.index(x)
+                        == (pos == cend(keys)
+                                ? packed.npos
+                                : static_cast<std::size_t>(pos
+                                                           - cbegin(keys))));
+            }
+        };
+
+        std::mt19937 gen {49u};
+
+        // Mostly sorted keys with small gaps compress by delta or frame.
+        std::vector<int> sorted (10'000);
+        for (auto i = std::size_t{1u}; i != sorted.size(); ++i)
+            sorted[i] = sorted[i - 1u] + static_cast<int>(gen() % 20u) - 2;
+
+        const CompressedList<int> packed_sorted {cbegin(sorted), cend(sorted)};
+        check(sorted, packed_sorted);
+        assert(packed_sorted.bytes() * 4u <= sorted.size() * 16u);
+
+        // Repetitive keys compress to runs.
+        std::vector<int> runs;
+        for (auto i = 0; i != 200; ++i)
+            runs.insert(end(runs), 50u + gen() % 100u, i % 7 - 3);
+
+        const CompressedList<int> packed_runs {cbegin(runs), cend(runs)};
+        check(runs, packed_runs);
+        assert(packed_runs.bytes() * 10u <= runs.size() * 16u);
+        assert(packed_runs.encoding(0u)
+                == CompressedList<int>::Encoding::runs);
+
+        // Random keys still round-trip, and the extremes of wider types do.
+        std::vector<int> noise (1'000);
+        for (auto& key : noise) key = static_cast<int>(gen());
+        check(noise, CompressedList<int>{cbegin(noise), cend(noise)});
+
+        using Lim = std::numeric_limits<long long>;
+        const std::vector<long long> extremes {Lim::max(), Lim::min(), 0,
+                                               -1, Lim::max(), Lim::min()};
+        check(extremes,
+              CompressedList<long long>{cbegin(extremes), cend(extremes)});
+
+        const std::vector<unsigned char> bytes {255, 0, 255, 255, 7};
+        check(bytes,
+              CompressedList<unsigned char>{cbegin(bytes), cend(bytes)});
+
+        const CompressedList<int> none;
+        check(std::vector<int>{}, none);
+        assert(none.index(0) == none.npos);
+
+        auto threw = false;
+        try {
+            none.min();
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        assert(threw);
+
+        threw = false;
+        try {
+            packed_sorted.at(sorted.size());
+        } catch (const std::out_of_range&) {
+            threw = true;
+        }
+        assert(threw);
+
+        // Lists of both kinds compress without copying their keys first.
+        Pool<ListNode<int>> pool;
+        const auto head = make_list(pool, 4, 4, 4, 2, 9);
+        assert(vec(CompressedList<int>{head}) == vec(head));
+        assert(CompressedList<int>{List<int>{head}}.count(4) == 3u);
+
+        const auto c_head = list_create(5, 3, 1, 4, 1, 5);
+        const auto c_packed = ek::clist::compress(c_head);
+        assert(vec(c_packed) == ek::clist::vec(c_head));
+        assert(c_packed.sum() == list_sum(c_head));
+        assert(static_cast<int>(c_packed.index(4)) == list_index(c_head, 4));
+        list_destroy(c_head);
+
+        std::cout << "compressed " << sorted.size() << " sorted keys to "
+                  << packed_sorted.bytes() << " bytes, " << runs.size()
+                  << " repetitive keys to " << packed_runs.bytes() << '\n';
+    }
+
+    void test_views()
+    {
+        Pool<ListNode<int>> pool;
+
+        std::vector<int> a (20);
+        std::iota(begin(a), end(a), 1);
+        const auto head = make_list(pool, a);
+        const List<int> list {head};
+
+        constexpr auto odd = [](const int x) { return x % 2 != 0; };
+        constexpr auto square = [](const int x) { return x * x; };
+        constexpr auto small = [](const int x) { return x < 200; };
+
+        // Nothing is traversed until collect, which traverses only once.
+        auto tests = 0;
+        const auto odds = filter(view(head), [&tests, odd](const int x) {
+            ++tests;
+            return odd(x);
+        });
+        const auto odd_squares = transform(odds, square);
+        const auto odd_small_squares = take_while(odd_squares, small);
+        assert(tests == 0);
+        const auto squares = collect(odd_small_squares);
+        assert(squares == (std::vector{1, 9, 25, 49, 81, 121, 169}));
+        assert(tests == 15);
+        std::cout << '\n' << P{squares} << '\n';
+
+        const auto sum = fold(transform(view(list), square), 0L,
+                              [](const long acc, const int x) {
+            return acc + x;
+        });
+        assert(sum == 2870L);
+
+        assert(count(view(list)) == 20u && count(view(head)) == 20u);
+        assert(count(filter(view(list), odd)) == 10u);
+        assert(count(chunk(view(list), 6u)) == 4u);
+        assert(count(chunk(view(head), 6u)) == 4u);
+
+        std::cout << "Chunks:";
+        for_each(chunk(view(head), 6u), [](const auto c) {
+            std::cout << ' ' << P{collect(c)};
+        });
+        std::cout << '\n';
+
+        const auto digits = make_list(pool, 3, 1, 4);
+        const auto pairs = collect(zip(view(digits), view(list)));
+        assert(pairs.size() == 3u && pairs[2] == (std::pair{4, 3}));
+
+        const auto sums = collect(transform(zip(view(list), view(head->next)),
+                                            [](const auto p) {
+            return p.first + p.second;
+        }));
+        assert(sums.size() == 19u && sums.front() == 3 && sums.back() == 39);
+
+        for_each(take(view(head), 3u), [](int& x) { x = -x; });
+        assert(vec(head)[2] == -3 && vec(head)[3] == 4);
+    }
+
+    template<typename T>
+    bool consistent(const List<T>& list)
+    {
+        const auto size = static_cast<std::size_t>(
+                std::distance(cbegin(list), cend(list)));
+
+        return List<T>{list.head()}.tail() == list.tail()
+                && size == list.size();
+    }
+
+    void test_take_smallest()
+    {
+        using std::pair;
+
+        constexpr auto by_first = [](const auto& lhs, const auto& rhs) {
+            return lhs.first < rhs.first;
+        };
+
+        Pool<ListNode<pair<int, int>>> pool;
+        std::mt19937 gen {2018u};
+        std::uniform_int_distribution<> key {0, 9};
+
+        for (std::size_t n = 0u; n != 30u; ++n) {
+            for (std::size_t k = 0u; k != n + 3u; ++k) {
+                std::vector<pair<int, int>> v (n);
+                auto i = 0;
+                for (auto& [x, tag] : v) std::tie(x, tag) = pair{key(gen), i++};
+
+                auto sorted = v;
+                std::stable_sort(begin(sorted), end(sorted), by_first);
+                const auto m = std::min(k, n);
+                const std::vector expected_taken (cbegin(sorted),
+                                                  cbegin(sorted) + m);
+
+                std::vector<pair<int, int>> expected_rest;
+                std::copy_if(cbegin(v), cend(v), back_inserter(expected_rest),
+                             [&](const auto& x) {
+                    return std::find(cbegin(expected_taken),
+                                     cend(expected_taken), x)
+                            == cend(expected_taken);
+                });
+
+                const auto [taken, rest] = take_smallest(make_list(pool, v),
+                                                         k, by_first);
+                assert(vec(taken) == expected_taken);
+                assert(vec(rest) == expected_rest);
+            }
+        }
+
+        Pool<ListNode<std::string_view>> ps;
+
+        auto head = make_list(ps, "foo"sv, "bar"sv, "baz"sv, "quux"sv,
+                                  "foobar"sv, "ab"sv);
+        const auto [three, others] = take_smallest(head, 3u);
+        std::cout << '\n' << three << ' ' << others << '\n';
+    }
+
+    // Counts comparisons, to show which lookups read nodes.
+    struct Counted {
+        int value;
+
+        bool operator==(const Counted& other) const noexcept
+        {
+            ++comparisons;
+            return value == other.value;
+        }
+
+        static inline auto comparisons = 0;
+    };
+
+    struct CountedHash {
+        std::size_t operator()(const Counted& x) const noexcept
+        {
+            return std::hash<int>{}(x.value);
+        }
+    };
+
+    void test_bloom_list()
+    {
+        Pool<ListNode<Counted>> pool;
+        std::vector<Counted> evens;
+        for (auto i = 0; i != 10'000; i += 2) evens.push_back({i});
+
+        ek::BloomList<Counted, CountedHash> list {pool, cbegin(evens),
+                                                   cend(evens), 0.01};
+        assert(list.size() == evens.size());
+
+        for (const auto& x : evens)
+            assert(list.find_node(x)->key.value == x.value);
+
+        auto walks = 0;
+        for (auto i = 1; i < 10'000; i += 2) {
+            Counted::comparisons = 0;
+            assert(!list.contains({i}));
+            if (Counted::comparisons != 0) ++walks;
+        }
+
+        std::cout << "BloomList: " << list.filter().bit_count() << " bits, "
+                  << list.filter().hash_count() << " hashes, " << walks
+                  << " of 5000 misses walked the list\n";
+        assert(walks < 150);
+
+        // Pushing keeps the filter up to date and grows it as needed.
+        for (auto i = 10'001; i < 30'000; i += 2) {
+            list.push_back(pool(Counted{i}, nullptr));
+            assert(list.contains({i}));
+        }
+
+        assert(list.filter().bit_count() >= 15'000u * 9u);
+        assert(list.contains({0}) && list.contains({29'999}));
+
+        list.push_front(pool(Counted{-1}, nullptr));
+        assert(list.head()->key.value == -1 && list.contains({-1}));
+
+        // Concatenating, merging, and splitting keep the filters current.
+        const auto by_value = [](const Counted& lhs, const Counted& rhs) {
+            return lhs.value < rhs.value;
+        };
+
+        ek::BloomList<Counted, CountedHash> small {
+                pool, {Counted{2}, Counted{5}, Counted{8}}};
+        small.concat(List<Counted>{pool, {Counted{10}, Counted{11}}});
+        assert(small.size() == 5u && small.contains({11}));
+
+        small.merge(List<Counted>{pool, {Counted{3}, Counted{9}}}, by_value);
+        assert(small.size() == 7u && small.contains({3}));
+        assert(small.contains({9}) && small.contains({11}));
+
+        const auto [odd, even] = small.split([](const Counted& x) {
+            return x.value % 2 != 0;
+        });
+        assert(odd.size() == 4u && even.size() == 3u);
+        for (const auto x : {3, 5, 9, 11}) assert(odd.contains({x}));
+        for (const auto x : {2, 8, 10}) assert(even.contains({x}));
+        assert(!even.contains({3}) && !odd.contains({2}));
+        assert(small.empty() && !small.contains({3}));
+
+        // An input range is read only once.
+        std::istringstream in {"4 8 15 16 23 42"};
+        Pool<ListNode<int>> ipool;
+        const ek::BloomList<int> read {ipool, std::istream_iterator<int>{in},
+                                       std::istream_iterator<int>{}};
+        assert(read.size() == 6u && read.contains(23) && !read.contains(5));
+    }
+
+    void test_hash_cons()
+    {
+        using namespace std::literals;
+
+        ek::ConsTable<std::string> table;
+
+        // Versions of a config, each changing one early line of the last.
+        std::vector<std::string> lines;
+        for (auto i = 0; i != 100; ++i)
+            lines.push_back("line "s + std::to_string(i));
+
+        std::vector<const ListNode<std::string>*> versions;
+        for (auto v = 0; v != 50; ++v) {
+            lines[static_cast<std::size_t>(v % 10)]
+                    = "edit "s + std::to_string(v);
+            versions.push_back(table.make_list(lines));
+        }
+
+        std::cout << "Nodes for 50 versions of 100 lines: " << table.size()
+                  << '\n';
+        assert(table.size() < 50u * 10u + 100u);
+
+        assert(table.make_list(lines) == versions.back());
+        assert(vec(versions.back()) == lines);
+        assert(versions[0] != versions[1]);
+        assert(!equal(versions[0], versions[1]));
+
+        // The lines after the first 10 are shared by every version.
+        const auto suffix = meet_node(versions[3], versions[40]);
+        assert(suffix && suffix->key == "line 10");
+        assert(suffix == meet_node(versions[0], versions[49]));
+
+        const auto abc = table.make_list({"a"s, "b"s, "c"s});
+        assert(table.cons("a"s, table.make_list({"b"s, "c"s})) == abc);
+        assert(table.cons("z"s, nullptr) != table.cons("y"s, nullptr));
+    }
+
+    void test_indexed_list()
+    {
+        Pool<ListNode<int>> pool;
+        ek::IndexedList<int> list {pool};
+        std::vector<int> model;
+
+        std::mt19937 gen {12345u};
+        std::uniform_int_distribution<> op {0, 2}, key {0, 300};
+
+        for (auto i = 0; i != 20'000; ++i) {
+            const auto x = key(gen);
+            const auto pos = std::find(begin(model), end(model), x);
+            const auto present = (pos != end(model));
+
+            switch (op(gen)) {
+            case 0:
+                assert(list.push_front(x).second == !present);
+                if (!present) model.insert(begin(model), x);
+                break;
+            case 1:
+                assert(list.push_back(x).second == !present);
+                if (!present) model.push_back(x);
+                break;
+            default:
+                assert(list.erase(x) == present);
+                if (present) model.erase(pos);
+                break;
+            }
+
+            const auto node = list.find_node(x);
+            assert(list.contains(x) == (node != nullptr));
+            assert(!node || node->key == x);
+        }
+
+        assert(vec(list.list()) == model);
+        assert(list.size() == model.size());
+        assert(!list.empty() && list.list().tail()->key == model.back());
+
+        // The index can be rebuilt for a list changed from outside.
+        const auto adopted = List<int>{pool, {5, 3, 8}};
+        ek::IndexedList<int> other {pool, adopted};
+        assert(other.find_node(3) == adopted.head()->next);
+
+        adopted.tail()->next = pool(13, nullptr);
+        other.rebuild();
+        assert(other.contains(13) && other.erase(5) && !other.contains(5));
+        other.push_back(21);
+        assert(vec(other.list()) == (std::vector{3, 8, 13, 21}));
+
+        std::cout << "IndexedList agrees with a vector after 20000 operations "
+                  << "(" << list.size() << " keys left)\n";
+    }
+
+    void test_lru_cache()
+    {
+        using std::pair;
+
+        ek::LruCache<int, std::string> cache {3u};
+        std::vector<pair<int, std::string>> evicted;
+        cache.on_evict([&evicted](const int key, const std::string& value) {
+            evicted.emplace_back(key, value);
+        });
+
+        assert(cache.put(1, "one") && cache.put(2, "two"));
+        assert(cache.put(3, "three") && !cache.put(2, "TWO"));
+        assert(*cache.get(1) == "one" && cache.size() == 3u);
+
+        // Now 3 is least recently used.
+        assert(cache.put(4, "four"));
+        assert(evicted == (std::vector{pair{3, std::string{"three"}}}));
+        assert(!cache.get(3) && cache.contains(2));
+
+        assert(cache.erase(1) && !cache.erase(1) && cache.size() == 2u);
+        assert(cache.put(5, "five") && evicted.size() == 1u);
+
+        std::vector<int> order;
+        for (const auto& entry : cache) order.push_back(entry.key);
+        assert((order == std::vector{5, 4, 2}));
+
+        // Random operations, against a vector ordered by recency.
+        ek::LruCache<int, int> big {100u};
+        std::vector<pair<int, int>> model;
+
+        std::mt19937 gen {12345u};
+        std::uniform_int_distribution<> op {0, 5}, key {0, 300};
+
+        for (auto i = 0; i != 50'000; ++i) {
+            const auto x = key(gen);
+            const auto pos = std::find_if(begin(model), end(model),
+                                          [x](const auto& e) {
+                return e.first == x;
+            });
+            const auto present = (pos != end(model));
+
+            switch (op(gen)) {
+            case 0:
+                assert(big.erase(x) == present);
+                if (present) model.erase(pos);
+                break;
+            case 1:
+            case 2:
+                assert((big.get(x) != nullptr) == present);
+                if (present) std::rotate(begin(model), pos, pos + 1);
+                break;
+            default:
+                assert(big.put(x, i) == !present);
+                if (present) model.erase(pos);
+                model.insert(begin(model), pair{x, i});
+                if (size(model) > 100u) model.pop_back();
+                break;
+            }
+        }
+
+        std::vector<pair<int, int>> contents;
+        for (const auto& entry : big)
+            contents.emplace_back(entry.key, entry.value);
+        assert(contents == model);
+
+        std::cout << "LruCache agrees with a vector after 50000 operations "
+                  << "(" << big.size() << " entries)\n";
+    }
+
+    void test_list_handle()
+    {
+        Pool<ListNode<int>> pool;
+
+        List<int> a {pool, {1, 4, 6, 9, 12, 15}};
+        List<int> b {pool, std::vector{2, 3, 5, 8, 13}};
+        List<int> c {make_list(pool, 7, 11)};
+        List<int> e;
+        assert(consistent(a) && consistent(b) && consistent(c));
+        assert(consistent(e) && e.empty());
+
+        std::cout << '\n' << a << ' ' << a.size() << '\n';
+
+        auto m = merge(a, b);
+        assert(consistent(m) && m.size() == 11u && m.tail()->key == 15);
+        std::cout << m << ' ' << m.size() << '\n';
+
+        auto [odd, even] = split(m, [](const int x) { return x % 2 != 0; });
+        assert(consistent(odd) && consistent(even));
+        assert(odd.size() == 6u && even.size() == 5u);
+        std::cout << odd << ' ' << even << '\n';
+
+        odd = reverse(odd);
+        assert(consistent(odd) && odd.head()->key == 15);
+
+        concat(even, c);
+        assert(consistent(even) && even.size() == 7u);
+        assert(meet_node(even, c) == c.head());
+        assert(meet_node(c, even) == c.head());
+        assert(meet(even, c) == begin(c));
+        assert(!meet_node(even, odd) && !meet_node(e, odd));
+        std::cout << even << ' ' << even.size() << '\n';
+
+        concat(e, odd);
+        assert(consistent(e) && equal(e, odd));
+        assert(!equal(e, even) && equal(List<int>{}, List<int>{}));
+
+        for (; !odd.empty(); odd = drop_min(odd)) {
+            assert(consistent(odd));
+            std::cout << odd << '\n';
+        }
+
+        for (auto i = 0; i != 4; ++i) even = drop_max(even);
+        assert(consistent(even) && vec(even) == (std::vector{2, 4, 6}));
+
+        even.push_front(pool(0, nullptr));
+        even.push_back(pool(10, nullptr));
+        assert(consistent(even) && vec(even) == (std::vector{0, 2, 4, 6, 10}));
+        std::cout << even << ' ' << even.size() << '\n';
+    }
 }
 
 void run_listnode_tests()
@@ -569,14 +1867,36 @@ void run_listnode_tests()
     test_print();
     test_splice();
     test_cycle();
+    test_find_cycle();
     test_copy();
+    test_clone();
+    test_emplace();
     test_find();
+    test_self_organizing();
     test_equal();
     test_equal_custom();
 
     test_reverse();
     test_split_merge();
+    test_split_n();
+    test_merge_adaptive();
+    test_merge_k();
+    test_sort();
+    test_external_sort();
+    test_find_nodes();
+    test_set_algebra();
     test_meet();
     test_meet_structural();
+    test_meet_index();
     test_drop();
+    test_take_smallest();
+    test_bloom_list();
+    test_hash_cons();
+    test_indexed_list();
+    test_lru_cache();
+    test_list_handle();
+    test_intrusive();
+    test_c_list();
+    test_compressed_list();
+    test_views();
 }
@@ -17,11 +17,13 @@
 #define HAVE_POOL_LISTNODE_HPP_
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstddef>
 #include <functional>
 #include <initializer_list>
 #include <iterator>
+#include <limits>
 #include <ostream>
 #include <stdexcept>
 #include <type_traits>
@@ -45,6 +47,14 @@ namespace ek {
                 noexcept(std::is_nothrow_move_constructible_v<T>)
             : key{std::move(_key)}, next{_next} { }
 
+        // Constructs the key in place from args, so pool(std::in_place,
+        // next, args...) makes no temporary key to copy or move.
+        template<typename... Args>
+        constexpr ListNode(std::in_place_t, ListNode* const _next,
+                           Args&&... args)
+            : key(detail::construct<T>(std::forward<Args>(args)...)),
+              next{_next} { }
+
         constexpr iterator begin() noexcept;
         constexpr iterator end() noexcept;
         constexpr const_iterator begin() const noexcept;
@@ -296,12 +306,19 @@ namespace ek {
         inline constexpr bool collects = collects_helper<C, T>(0).value;
     }
 
+    // If c is an rvalue, its elements are moved into the nodes.
     template<typename T, typename C>
     inline std::enable_if_t<detail::collects<C, T>, ListNode<T>*>
     make_list(Pool<ListNode<T>>& pool, C&& c)
     {
         using std::begin, std::end;
-        return make_list(pool, begin(c), end(c));
+
+        if constexpr (std::is_lvalue_reference_v<C>) {
+            return make_list(pool, begin(c), end(c));
+        } else {
+            return make_list(pool, std::make_move_iterator(begin(c)),
+                             std::make_move_iterator(end(c)));
+        }
     }
 
     template<typename T>
@@ -329,6 +346,16 @@ namespace ek {
         return pool(std::move(x), make_list(pool, std::forward<Ts>(xs)...));
     }
 
+    // Copies a list into a pool in one pass. A Pool stores objects made one
+    // after another together, so however scattered the original nodes were,
+    // the copy is laid out in list order.
+    template<typename T>
+    inline ListNode<T>* clone(Pool<ListNode<T>>& pool,
+                              const ListNode<T>* const head)
+    {
+        return make_list(pool, cbegin(head), cend(head));
+    }
+
     template<typename T>
     void concat(ListNode<T>* src_head, ListNode<T>* const dest_node) noexcept
     {
@@ -346,16 +373,26 @@ namespace ek {
     }
 
     namespace detail {
+        // Brent's algorithm. Unlike Floyd's, only one iterator advances, and
+        // the other just teleports to it whenever a power-of-two count of
+        // steps has elapsed since the last time it did so.
         template<typename I>
-        bool has_cycle_helper(I first, const I last,
+        bool has_cycle_helper(const I first, const I last,
                               std::forward_iterator_tag) noexcept
         {
-            auto leader = first;
+            if (first == last) return false;
 
-            while (leader != last && ++leader != last) {
-                if (first == leader) return true;
-                ++first;
-                ++leader;
+            auto tortoise = first, hare = std::next(first);
+
+            for (std::size_t power = 1u, lambda = 1u; hare != last;
+                                                      ++hare, ++lambda) {
+                if (hare == tortoise) return true;
+
+                if (lambda == power) {
+                    tortoise = hare;
+                    power *= 2u;
+                    lambda = 0u;
+                }
             }
 
             return false;
@@ -375,6 +412,60 @@ namespace ek {
         return has_cycle(cbegin(head), cend(head));
     }
 
+    // The result of find_cycle. If there is no cycle, entry is null,
+    // tail_length is the length of the list, and cycle_length is zero.
+    template<typename P>
+    struct CycleInfo {
+        P entry;
+        std::size_t tail_length;
+        std::size_t cycle_length;
+    };
+
+    namespace detail {
+        template<typename P>
+        CycleInfo<P> find_cycle_helper(const P head) noexcept
+        {
+            if (!head) return {nullptr, 0u, 0u};
+
+            // Find the cycle length by Brent's algorithm (see has_cycle).
+            P tortoise {head}, hare {head->next};
+            std::size_t power = 1u, lambda = 1u, steps = 1u;
+
+            for (; hare != tortoise; hare = hare->next, ++lambda, ++steps) {
+                if (!hare) return {nullptr, steps, 0u};
+
+                if (lambda == power) {
+                    tortoise = hare;
+                    power *= 2u;
+                    lambda = 0u;
+                }
+            }
+
+            // Start the hare a full cycle ahead, so they meet at the entry.
+            tortoise = hare = head;
+            for (auto i = lambda; i != 0u; --i) hare = hare->next;
+
+            std::size_t mu {};
+            for (; tortoise != hare; tortoise = tortoise->next, ++mu)
+                hare = hare->next;
+
+            return {tortoise, mu, lambda};
+        }
+    }
+
+    template<typename T>
+    inline CycleInfo<const ListNode<T>*>
+    find_cycle(const ListNode<T>* const head) noexcept
+    {
+        return detail::find_cycle_helper(head);
+    }
+
+    template<typename T>
+    inline CycleInfo<ListNode<T>*> find_cycle(ListNode<T>* const head) noexcept
+    {
+        return detail::find_cycle_helper(head);
+    }
+
     namespace detail {
         template<typename I1, typename I2>
         void crop_front(I1& first1, const I1 last1,
@@ -567,6 +658,69 @@ namespace ek {
         return detail::node<T>(find_if_not(head, f));
     }
 
+    // Self-organizing lookups: if a node is found, these relink it toward the
+    // front of the list, changing head if needed, so keys that are looked up
+    // often end up found quickly. Move-to-front adapts faster; transposing
+    // (swapping with the previous node) is more stable under skewed but
+    // shifting workloads. These return the found node or a null pointer.
+    template<typename T, typename F>
+    ListNode<T>* find_if_mtf(ListNode<T>*& head, const F f)
+        noexcept(noexcept(f(head->key)))
+    {
+        auto destp = &head;
+        while (*destp && !f((*destp)->key)) destp = &(*destp)->next;
+
+        const auto node = *destp;
+
+        if (node && destp != &head) {
+            *destp = node->next;
+            node->next = head;
+            head = node;
+        }
+
+        return node;
+    }
+
+    template<typename T, typename U>
+    inline ListNode<T>* find_mtf(ListNode<T>*& head, const U& key)
+        noexcept(noexcept(head->key == key))
+    {
+        return find_if_mtf(head, [&key](const T& x) { return x == key; });
+    }
+
+    template<typename T, typename F>
+    ListNode<T>* find_if_transpose(ListNode<T>*& head, const F f)
+        noexcept(noexcept(f(head->key)))
+    {
+        ListNode<T>** prev_destp {};
+        auto destp = &head;
+
+        while (*destp && !f((*destp)->key)) {
+            prev_destp = destp;
+            destp = &(*destp)->next;
+        }
+
+        const auto node = *destp;
+
+        if (node && prev_destp) {
+            const auto prev = *prev_destp;
+            prev->next = node->next;
+            node->next = prev;
+            *prev_destp = node;
+        }
+
+        return node;
+    }
+
+    template<typename T, typename U>
+    inline ListNode<T>* find_transpose(ListNode<T>*& head, const U& key)
+        noexcept(noexcept(head->key == key))
+    {
+        return find_if_transpose(head, [&key](const T& x) {
+            return x == key;
+        });
+    }
+
     constexpr bool equal(std::nullptr_t, std::nullptr_t) noexcept
     {
         return true;
@@ -704,6 +858,141 @@ namespace ek {
         return {true_head, false_head};
     }
 
+    namespace detail {
+        // Moves each node to the end of the list of heads[f(key)], for k
+        // lists. Each destps[i] is the address of the null link ending that
+        // list. If Checked, an index of k or more throws std::out_of_range
+        // after ending the lists, with that node and the rest still linked.
+        template<bool Checked, typename T, typename H, typename D, typename F>
+        void split_n_helper(ListNode<T>* head, const H heads, const D destps,
+                            const std::size_t k, F f)
+            noexcept(!Checked && noexcept(f(head->key)))
+        {
+            for (auto i = std::size_t{0u}; i != k; ++i) {
+                heads[i] = nullptr;
+                destps[i] = &heads[i];
+            }
+
+            for (; head; head = head->next) {
+                const auto i = static_cast<std::size_t>(f(head->key));
+
+                if constexpr (Checked) {
+                    if (i >= k) {
+                        for (auto j = std::size_t{0u}; j != k; ++j)
+                            *destps[j] = nullptr;
+                        throw std::out_of_range{"bucket index out of range"};
+                    }
+                } else {
+                    assert(i < k);
+                }
+
+                *destps[i] = head;
+                destps[i] = &head->next;
+            }
+
+            for (auto i = std::size_t{0u}; i != k; ++i) *destps[i] = nullptr;
+        }
+    }
+
+    // Partitions a list into K lists by the bucket index f returns for each
+    // key, in a single pass that keeps relative order in each bucket. The
+    // heads and tail links are kept in arrays on the stack.
+    template<std::size_t K, typename T, typename F>
+    std::array<ListNode<T>*, K> split_n(ListNode<T>* const head, F f)
+        noexcept(noexcept(f(head->key)))
+    {
+        static_assert(K != 0u);
+
+        std::array<ListNode<T>*, K> heads;
+        std::array<ListNode<T>**, K> destps;
+        detail::split_n_helper<false>(head, begin(heads), begin(destps), K, f);
+        return heads;
+    }
+
+    // Like split_n<K>, but with the number of buckets known only at runtime,
+    // and without allocating: the k heads are written to [heads_first,
+    // heads_last), and tails, which must have room for k ListNode<T>**, holds
+    // the tail links. Both must be random access. Throws invalid_argument if
+    // k is 0, before touching the list, and out_of_range if f returns an index
+    // of k or more, in which case the buckets end just before that node.
+    template<typename T, typename I, typename J, typename F>
+    void split_n(ListNode<T>* const head, const I heads_first,
+                 const I heads_last, const J tails, F f)
+    {
+        const auto k = static_cast<std::size_t>(heads_last - heads_first);
+        if (k == 0u)
+            throw std::invalid_argument{"split_n needs at least one bucket"};
+
+        detail::split_n_helper<true>(head, heads_first, tails, k, f);
+    }
+
+    // Like the above, but allocating the storage, for convenience.
+    template<typename T, typename F>
+    std::vector<ListNode<T>*>
+    split_n(ListNode<T>* const head, const std::size_t k, F f)
+    {
+        std::vector<ListNode<T>*> heads (k);
+        std::vector<ListNode<T>**> destps (k);
+        split_n(head, begin(heads), end(heads), begin(destps), f);
+        return heads;
+    }
+
+    namespace detail {
+        // How many times in a row one list must supply the next node in merge
+        // before merge looks ahead to find more nodes it can take together.
+        inline constexpr std::size_t min_gallop = 7u;
+
+        // Given a node whose key satisfies pred, finds the last node of the
+        // run starting there whose keys all satisfy pred. This is exponential
+        // then binary search, so it calls pred O(log n) times, though it still
+        // follows O(n) links.
+        template<typename T, typename F>
+        ListNode<T>* gallop(ListNode<T>* good, F pred)
+            noexcept(noexcept(pred(good->key)))
+        {
+            auto step = std::size_t{1u};
+
+            // Look ahead 1, 2, 4, ... nodes, until we find one that fails.
+            for (; ; step *= 2u) {
+                auto probe = good;
+                auto i = std::size_t{0u};
+                for (; i != step && probe->next; ++i) probe = probe->next;
+
+                if (i == 0u) return good;
+
+                if (!pred(probe->key)) {
+                    step = i;
+                    break;
+                }
+
+                good = probe;
+                if (i != step) return good;
+            }
+
+            // Now good satisfies pred and the node step links later doesn't.
+            while (step > 1u) {
+                const auto half = step / 2u;
+
+                auto mid = good;
+                for (auto i = half; i != 0u; --i) mid = mid->next;
+
+                if (pred(mid->key)) {
+                    good = mid;
+                    step -= half;
+                } else {
+                    step = half;
+                }
+            }
+
+            return good;
+        }
+    }
+
+    // Stably merges two sorted lists. In the usual case, nodes are selected
+    // by indexing rather than branching on the comparison, since branching is
+    // unpredictable when the lists interleave. But when one list supplies
+    // min_gallop nodes in a row, merge gallops over the rest of that run, as
+    // in Timsort, so long runs take logarithmically many comparisons.
     template<typename T, typename F>
     ListNode<T>* merge(ListNode<T>* head1, ListNode<T>* head2, F f)
         noexcept(noexcept(f(head2->key, head1->key)))
@@ -711,13 +1000,38 @@ namespace ek {
         ListNode<T>* ret {};
         auto destp = &ret;
 
-        for (; head1 && head2; destp = &(*destp)->next) {
-            auto& src = f(head2->key, head1->key) ? head2 : head1;
-            *destp = src;
-            src = src->next;
+        ListNode<T>* heads[] {head1, head2};
+        std::size_t last {}, streak {};
+
+        while (heads[0] && heads[1]) {
+            const std::size_t i = f(heads[1]->key, heads[0]->key);
+            const auto node = heads[i];
+
+            if (i == last && streak >= detail::min_gallop) {
+                const auto& pivot = heads[1u - i]->key;
+
+                const auto end = (i == 0u
+                    ? detail::gallop(node, [&](const T& x) {
+                        return !f(pivot, x);
+                    })
+                    : detail::gallop(node, [&](const T& x) {
+                        return f(x, pivot);
+                    }));
+
+                *destp = node;
+                destp = &end->next;
+                heads[i] = end->next;
+                streak = 0u;
+            } else {
+                *destp = node;
+                destp = &node->next;
+                heads[i] = node->next;
+                streak = (i == last) * streak + 1u;
+                last = i;
+            }
         }
 
-        *destp = (head1 ? head1 : head2);
+        *destp = (heads[0] ? heads[0] : heads[1]);
         return ret;
     }
 
@@ -728,6 +1042,313 @@ namespace ek {
         return merge(head1, head2, std::less{});
     }
 
+    namespace detail {
+        // A stable bottom-up merge sort that relinks the nodes, in O(n log n)
+        // time and O(1) space, for both sort and intrusive::sort. next(node)
+        // gives a reference to node's link, and merge stably merges two runs.
+        // As in binary counting, bins[i] is either empty or a sorted run of
+        // 2**i nodes, all of which came before those in lower bins, so
+        // merging into a run from its bin first keeps ties in order.
+        template<typename N, typename G, typename M>
+        N* bin_sort(N* head, G next, M merge)
+            noexcept(noexcept(merge(head, head)))
+        {
+            N* bins[std::numeric_limits<std::size_t>::digits] {};
+            auto used = std::size_t{0u};
+
+            while (head) {
+                auto run = head;
+                head = next(*head);
+                next(*run) = nullptr;
+
+                auto i = std::size_t{0u};
+                for (; i != used && bins[i]; ++i) {
+                    run = merge(bins[i], run);
+                    bins[i] = nullptr;
+                }
+
+                if (i == used) ++used;
+                bins[i] = run;
+            }
+
+            N* ret {};
+            for (auto i = std::size_t{0u}; i != used; ++i)
+                if (bins[i]) ret = merge(bins[i], ret);
+
+            return ret;
+        }
+    }
+
+    // A stable bottom-up merge sort that relinks the nodes, like
+    // intrusive::sort but with the merge above, so presorted stretches merge
+    // with few comparisons.
+    template<typename T, typename F>
+    ListNode<T>* sort(ListNode<T>* const head, F f)
+        noexcept(noexcept(f(head->key, head->key)))
+    {
+        return detail::bin_sort(head,
+                [](ListNode<T>& node) noexcept -> ListNode<T>*& {
+                    return node.next;
+                },
+                [&f](ListNode<T>* const head1, ListNode<T>* const head2) {
+                    return merge(head1, head2, f);
+                });
+    }
+
+    template<typename T>
+    inline ListNode<T>* sort(ListNode<T>* const head)
+        noexcept(noexcept(sort(head, std::less{})))
+    {
+        return sort(head, std::less{});
+    }
+
+    namespace detail {
+        // Which nodes a set operation keeps: those only in the first list,
+        // those only in the second, and (from the first list) those in both.
+        struct SetOp {
+            bool only1, only2, both;
+        };
+
+        // Each node in one list cancels at most one equivalent node in the
+        // other, as in std::set_union and the like. As in merge, once one list
+        // has supplied min_gallop unmatched nodes in a row, the rest of its
+        // run is found by galloping, which makes O(log r) comparisons for a
+        // run of length r, so a short list of length m costs O(m log(n/m))
+        // comparisons against a long list of length n.
+        template<typename T, typename F>
+        ListNode<T>* set_operation(ListNode<T>* head1, ListNode<T>* head2,
+                                   F f, const SetOp op)
+            noexcept(noexcept(f(head1->key, head2->key)))
+        {
+            ListNode<T>* ret {};
+            auto destp = &ret;
+
+            const auto take = [&destp](ListNode<T>* const first,
+                                       ListNode<T>* const last) noexcept {
+                *destp = first;
+                destp = &last->next;
+            };
+
+            std::size_t last {}, streak {};
+
+            // Finds the end of the unmatched run starting at head, in list i,
+            // of keys less than pivot: just head, or more if galloping.
+            const auto run_end = [&](ListNode<T>* const head,
+                                     const std::size_t i, const T& pivot) {
+                if (i == last && streak >= min_gallop) {
+                    streak = 0u;
+                    return gallop(head, [&](const T& x) {
+                        return f(x, pivot);
+                    });
+                }
+
+                streak = (i == last) * streak + 1u;
+                last = i;
+                return head;
+            };
+
+            while (head1 && head2) {
+                if (f(head1->key, head2->key)) {
+                    const auto end = run_end(head1, 0u, head2->key);
+                    if (op.only1) take(head1, end);
+                    head1 = end->next;
+                } else if (f(head2->key, head1->key)) {
+                    const auto end = run_end(head2, 1u, head1->key);
+                    if (op.only2) take(head2, end);
+                    head2 = end->next;
+                } else {
+                    if (op.both) take(head1, head1);
+                    head1 = head1->next;
+                    head2 = head2->next;
+                    streak = 0u;
+                }
+            }
+
+            *destp = (op.only1 && head1 ? head1
+                        : op.only2 && head2 ? head2
+                        : nullptr);
+            return ret;
+        }
+    }
+
+    // Set operations on sorted lists relink the nodes they keep into the
+    // result, taking nodes from the first list when both have an equivalent
+    // node. Nodes left out are still in their Pool, but their links are not
+    // meaningful afterwards.
+    template<typename T, typename F>
+    inline ListNode<T>* set_union(ListNode<T>* const head1,
+                                  ListNode<T>* const head2, const F f)
+        noexcept(noexcept(f(head1->key, head2->key)))
+    {
+        return detail::set_operation(head1, head2, f, {true, true, true});
+    }
+
+    template<typename T>
+    inline ListNode<T>* set_union(ListNode<T>* const head1,
+                                  ListNode<T>* const head2)
+        noexcept(noexcept(set_union(head1, head2, std::less{})))
+    {
+        return set_union(head1, head2, std::less{});
+    }
+
+    template<typename T, typename F>
+    inline ListNode<T>* set_intersection(ListNode<T>* const head1,
+                                         ListNode<T>* const head2, const F f)
+        noexcept(noexcept(f(head1->key, head2->key)))
+    {
+        return detail::set_operation(head1, head2, f, {false, false, true});
+    }
+
+    template<typename T>
+    inline ListNode<T>* set_intersection(ListNode<T>* const head1,
+                                         ListNode<T>* const head2)
+        noexcept(noexcept(set_intersection(head1, head2, std::less{})))
+    {
+        return set_intersection(head1, head2, std::less{});
+    }
+
+    template<typename T, typename F>
+    inline ListNode<T>* set_difference(ListNode<T>* const head1,
+                                       ListNode<T>* const head2, const F f)
+        noexcept(noexcept(f(head1->key, head2->key)))
+    {
+        return detail::set_operation(head1, head2, f, {true, false, false});
+    }
+
+    template<typename T>
+    inline ListNode<T>* set_difference(ListNode<T>* const head1,
+                                       ListNode<T>* const head2)
+        noexcept(noexcept(set_difference(head1, head2, std::less{})))
+    {
+        return set_difference(head1, head2, std::less{});
+    }
+
+    template<typename T, typename F>
+    inline ListNode<T>* set_symmetric_difference(ListNode<T>* const head1,
+                                                 ListNode<T>* const head2,
+                                                 const F f)
+        noexcept(noexcept(f(head1->key, head2->key)))
+    {
+        return detail::set_operation(head1, head2, f, {true, true, false});
+    }
+
+    template<typename T>
+    inline ListNode<T>* set_symmetric_difference(ListNode<T>* const head1,
+                                                 ListNode<T>* const head2)
+        noexcept(noexcept(set_symmetric_difference(head1, head2,
+                                                   std::less{})))
+    {
+        return set_symmetric_difference(head1, head2, std::less{});
+    }
+
+    namespace detail {
+        // A tournament tree of losers over k runs. Each internal node t, for
+        // t in [1, k), holds the run that lost the match played there, and
+        // losers_[0] holds the winner. So replaying a leaf takes log k matches.
+        template<typename T, typename F>
+        class LoserTree {
+        public:
+            template<typename I>
+            LoserTree(I first, I last, F f);
+
+            ListNode<T>* pop();
+
+            // The node pop would return next, and the index of its run.
+            ListNode<T>* top() const noexcept
+            {
+                return empty(heads_) ? nullptr : heads_[losers_[0]];
+            }
+
+            std::size_t top_run() const noexcept { return losers_[0]; }
+
+        private:
+            // Is run a's head ordered before run b's? Exhausted runs lose to
+            // all others, and ties go to the lower index, for stability.
+            bool beats(std::size_t a, std::size_t b);
+
+            void replay(std::size_t leaf);
+
+            std::vector<ListNode<T>*> heads_;
+            std::vector<std::size_t> losers_;
+            F f_;
+        };
+
+        template<typename T, typename F>
+        template<typename I>
+        LoserTree<T, F>::LoserTree(const I first, const I last, const F f)
+            : heads_(first, last), losers_(size(heads_), size(heads_)), f_{f}
+        {
+            // Index k (out of range) is a sentinel that beats every run.
+            for (auto leaf = size(heads_); leaf-- != 0u; ) replay(leaf);
+        }
+
+        template<typename T, typename F>
+        ListNode<T>* LoserTree<T, F>::pop()
+        {
+            if (empty(heads_)) return nullptr;
+
+            const auto winner = losers_[0];
+            const auto node = heads_[winner];
+            if (!node) return nullptr;
+
+            heads_[winner] = node->next;
+            replay(winner);
+            return node;
+        }
+
+        template<typename T, typename F>
+        bool LoserTree<T, F>::beats(const std::size_t a, const std::size_t b)
+        {
+            const auto k = size(heads_);
+            if (a == k) return true;
+            if (b == k) return false;
+
+            const auto p = heads_[a], q = heads_[b];
+            if (!p || !q) return !q;
+
+            return a < b ? !f_(q->key, p->key) : f_(p->key, q->key);
+        }
+
+        template<typename T, typename F>
+        void LoserTree<T, F>::replay(std::size_t leaf)
+        {
+            for (auto t = (leaf + size(heads_)) / 2u; t != 0u; t /= 2u)
+                if (beats(losers_[t], leaf)) std::swap(leaf, losers_[t]);
+
+            losers_[0] = leaf;
+        }
+    }
+
+    // Merges the sorted lists whose heads are in [first, last), taking from
+    // earlier lists first on ties. This uses O(n log k) comparisons, relinks
+    // the existing nodes, and allocates only O(k) space for the tree itself.
+    template<typename I, typename F>
+    auto merge_k(const I first, const I last, const F f)
+    {
+        using N = std::remove_pointer_t<
+                typename std::iterator_traits<I>::value_type>;
+        using T = decltype(std::declval<N&>().key);
+
+        detail::LoserTree<T, F> tree {first, last, f};
+
+        ListNode<T>* ret {};
+        auto destp = &ret;
+
+        for (auto node = tree.pop(); node; node = tree.pop()) {
+            *destp = node;
+            destp = &node->next;
+        }
+
+        *destp = nullptr;
+        return ret;
+    }
+
+    template<typename I>
+    inline auto merge_k(const I first, const I last)
+    {
+        return merge_k(first, last, std::less{});
+    }
+
     template<typename T, typename F>
     ListNode<T>* drop_min(ListNode<T>* head, F f)
     {
@@ -761,6 +1382,88 @@ namespace ek {
     {
         return drop_min(head, std::greater{});
     }
+
+    // Detaches the k smallest nodes (all of them, if there are no more than
+    // k), returning them in sorted order and the rest in their original order.
+    // Of nodes with equivalent keys, those earlier in the list are taken first.
+    // This is O(n log k): one pass selects the k smallest nodes with a bounded
+    // max-heap of nodes and their positions, which break ties, and the heap
+    // is then sorted in place. The rest are relinked only up to the last node
+    // taken.
+    template<typename T, typename F>
+    std::pair<ListNode<T>*, ListNode<T>*>
+    take_smallest(ListNode<T>* const head, const std::size_t k, F f)
+    {
+        if (k == 0u) return {nullptr, head};
+
+        using Entry = std::pair<ListNode<T>*, std::size_t>;
+
+        const auto entry_less = [&f](const Entry& lhs, const Entry& rhs) {
+            if (f(lhs.first->key, rhs.first->key)) return true;
+            if (f(rhs.first->key, lhs.first->key)) return false;
+            return lhs.second < rhs.second;
+        };
+
+        std::vector<Entry> best;
+        auto pos = std::size_t{0u};
+
+        for (auto cur = head; cur; cur = cur->next, ++pos) {
+            if (size(best) < k) {
+                best.emplace_back(cur, pos);
+                std::push_heap(begin(best), end(best), entry_less);
+            } else if (f(cur->key, best.front().first->key)) {
+                std::pop_heap(begin(best), end(best), entry_less);
+                best.back() = {cur, pos};
+                std::push_heap(begin(best), end(best), entry_less);
+            }
+        }
+
+        if (empty(best)) return {nullptr, nullptr};
+
+        std::sort_heap(begin(best), end(best), entry_less);
+
+        // A node is taken exactly when it comes no later than the greatest
+        // kept node, in the order of keys and then positions.
+        const auto bound = best.back();
+        const auto last = std::max_element(cbegin(best), cend(best),
+                                [](const Entry& lhs, const Entry& rhs) {
+            return lhs.second < rhs.second;
+        })->second;
+
+        ListNode<T>* rest {};
+        auto rest_destp = &rest;
+        auto cur = head;
+
+        for (pos = 0u; pos <= last; ++pos) {
+            const auto next = cur->next;
+
+            if (entry_less(bound, Entry{cur, pos})) {
+                *rest_destp = cur;
+                rest_destp = &cur->next;
+            }
+
+            cur = next;
+        }
+
+        *rest_destp = cur;
+
+        ListNode<T>* ret {};
+        auto destp = &ret;
+        for (const auto& entry : best) {
+            *destp = entry.first;
+            destp = &entry.first->next;
+        }
+
+        *destp = nullptr;
+        return {ret, rest};
+    }
+
+    template<typename T>
+    inline std::pair<ListNode<T>*, ListNode<T>*>
+    take_smallest(ListNode<T>* const head, const std::size_t k)
+    {
+        return take_smallest(head, k, std::less{});
+    }
 }
 
 #endif // ! HAVE_POOL_LISTNODE_HPP_
@@ -0,0 +1,4 @@
+// A fixed-capacity LRU cache built on ListNode.
+// SPDX-License-Identifier: 0BSD
+
+#include "LruCache.hpp"
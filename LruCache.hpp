@@ -0,0 +1,250 @@
+// A fixed-capacity least-recently-used cache whose recency order is a list of
+// Pool-allocated ListNode objects, found through an open-addressed index.
+//
+// Copyright (c) 2018 Eliah Kagan
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+// SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+// OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+// CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef HAVE_POOL_LRUCACHE_HPP_
+#define HAVE_POOL_LRUCACHE_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "Hash.hpp"
+#include "ListNode.hpp"
+#include "Pool.hpp"
+
+namespace ek {
+    // What each node of an LruCache's recency list holds. The list runs from
+    // the most to the least recently used entry, and prev links back toward
+    // the front, so entries can be moved and removed in O(1) time without
+    // looking up their neighbors.
+    template<typename K, typename V>
+    struct LruEntry {
+        K key;
+        V value;
+        ListNode<LruEntry>* prev;
+    };
+
+    // The index is sized for the capacity up front, and nodes of evicted and
+    // erased entries are reused, so once the cache has been full, get, put,
+    // and erase do not allocate. K and V must be copy or move assignable,
+    // since reused nodes are assigned new keys and values.
+    template<typename K, typename V, typename H = std::hash<K>,
+             typename E = std::equal_to<K>>
+    class LruCache {
+    public:
+        using Node = ListNode<LruEntry<K, V>>;
+        using const_iterator = typename Node::const_iterator;
+
+        explicit LruCache(std::size_t capacity, H hash = H{},
+                          E key_eq = E{});
+
+        LruCache(const LruCache&) = delete;
+        LruCache& operator=(const LruCache&) = delete;
+
+        std::size_t size() const noexcept { return size_; }
+        std::size_t capacity() const noexcept { return capacity_; }
+        bool empty() const noexcept { return size_ == 0u; }
+
+        // Unlike get, this does not count as a use.
+        bool contains(const K& key) const
+        {
+            return slots_[probe(key, hash_of(key))].node;
+        }
+
+        // Returns the value for the key, or null if there is none, and makes
+        // the entry the most recently used.
+        V* get(const K& key);
+
+        // Sets the value for the key and makes the entry the most recently
+        // used, evicting the least recently used entry if the cache is full.
+        // Returns whether the key is new.
+        bool put(const K& key, V value);
+
+        // Removes the entry. Returns whether there was one. The value is not
+        // destroyed until its node is reused or the cache is destroyed.
+        bool erase(const K& key);
+
+        // Sets a function that is called as f(key, value) on each entry just
+        // before it is evicted to make room. Erased entries are not passed.
+        template<typename F>
+        void on_evict(F f) { evict_ = std::move(f); }
+
+        // Entries, from the most to the least recently used.
+        const_iterator begin() const noexcept { return const_iterator{head_}; }
+        const_iterator end() const noexcept { return const_iterator{}; }
+
+    private:
+        struct Slot {
+            std::size_t hash;
+            Node* node;
+        };
+
+        std::size_t hash_of(const K& key) const
+        {
+            return detail::mix_hash(hash_(key));
+        }
+
+        // Finds the slot with the key, or the empty slot where it would go.
+        std::size_t probe(const K& key, std::size_t h) const;
+
+        void unlink(Node* node) noexcept;
+
+        void link_front(Node* node) noexcept;
+
+        std::size_t capacity_;
+        std::size_t size_ {};
+        Pool<Node> pool_;
+        Node* free_ {};
+        Node* head_ {};
+        Node* tail_ {};
+        std::vector<Slot> slots_;
+        H hash_;
+        E key_eq_;
+        std::function<void(const K&, V&)> evict_;
+    };
+
+    template<typename K, typename V, typename H, typename E>
+    LruCache<K, V, H, E>::LruCache(const std::size_t capacity, const H hash,
+                                   const E key_eq)
+        : capacity_{capacity}, hash_{hash}, key_eq_{key_eq}
+    {
+        if (capacity == 0u)
+            throw std::invalid_argument{"LRU cache capacity must be positive"};
+
+        detail::reserve_slots(slots_, capacity);
+    }
+
+    template<typename K, typename V, typename H, typename E>
+    V* LruCache<K, V, H, E>::get(const K& key)
+    {
+        const auto node = slots_[probe(key, hash_of(key))].node;
+        if (!node) return nullptr;
+
+        if (node != head_) {
+            unlink(node);
+            link_front(node);
+        }
+
+        return &node->key.value;
+    }
+
+    template<typename K, typename V, typename H, typename E>
+    bool LruCache<K, V, H, E>::put(const K& key, V value)
+    {
+        const auto h = hash_of(key);
+        auto slot = probe(key, h);
+
+        if (const auto node = slots_[slot].node) {
+            node->key.value = std::move(value);
+            if (node != head_) {
+                unlink(node);
+                link_front(node);
+            }
+            return false;
+        }
+
+        Node* node {};
+
+        if (size_ == capacity_) {
+            node = tail_;
+            if (evict_) evict_(node->key.key, node->key.value);
+
+            unlink(node);
+            detail::erase_slot(slots_,
+                               probe(node->key.key, hash_of(node->key.key)));
+            --size_;
+
+            // Removal can shift slots, so where the key goes may change.
+            slot = probe(key, h);
+        } else if (free_) {
+            node = free_;
+            free_ = free_->next;
+        }
+
+        if (node) {
+            node->key.key = key;
+            node->key.value = std::move(value);
+        } else {
+            node = pool_(std::in_place, nullptr, key, std::move(value),
+                         nullptr);
+        }
+
+        slots_[slot] = {h, node};
+        link_front(node);
+        ++size_;
+        return true;
+    }
+
+    template<typename K, typename V, typename H, typename E>
+    bool LruCache<K, V, H, E>::erase(const K& key)
+    {
+        const auto slot = probe(key, hash_of(key));
+        const auto node = slots_[slot].node;
+        if (!node) return false;
+
+        unlink(node);
+        detail::erase_slot(slots_, slot);
+        --size_;
+
+        node->next = free_;
+        free_ = node;
+        return true;
+    }
+
+    template<typename K, typename V, typename H, typename E>
+    std::size_t
+    LruCache<K, V, H, E>::probe(const K& key, const std::size_t h) const
+    {
+        return detail::probe_slot(slots_, h, [&](const Slot& slot) {
+            return key_eq_(slot.node->key.key, key);
+        });
+    }
+
+    template<typename K, typename V, typename H, typename E>
+    void LruCache<K, V, H, E>::unlink(Node* const node) noexcept
+    {
+        const auto prev = node->key.prev, next = node->next;
+
+        (prev ? prev->next : head_) = next;
+        (next ? next->key.prev : tail_) = prev;
+    }
+
+    template<typename K, typename V, typename H, typename E>
+    void LruCache<K, V, H, E>::link_front(Node* const node) noexcept
+    {
+        node->key.prev = nullptr;
+        node->next = head_;
+        (head_ ? head_->key.prev : tail_) = node;
+        head_ = node;
+    }
+
+    template<typename K, typename V, typename H, typename E>
+    inline typename LruCache<K, V, H, E>::const_iterator
+    begin(const LruCache<K, V, H, E>& cache) noexcept
+    {
+        return cache.begin();
+    }
+
+    template<typename K, typename V, typename H, typename E>
+    inline typename LruCache<K, V, H, E>::const_iterator
+    end(const LruCache<K, V, H, E>& cache) noexcept
+    {
+        return cache.end();
+    }
+}
+
+#endif // ! HAVE_POOL_LRUCACHE_HPP_
@@ -0,0 +1,4 @@
+// An index answering where any two of many ListNode lists meet.
+// SPDX-License-Identifier: 0BSD
+
+#include "MeetIndex.hpp"
@@ -0,0 +1,235 @@
+// An index of many ListNode lists that may share tails, answering where any
+// two of them meet without walking either again.
+//
+// Copyright (c) 2018 Eliah Kagan
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+// SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+// OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+// CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef HAVE_POOL_MEETINDEX_HPP_
+#define HAVE_POOL_MEETINDEX_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "Hash.hpp"
+#include "ListNode.hpp"
+
+namespace ek {
+    // Lists are numbered in the order given. Each list is walked only until
+    // it reaches a node an earlier list already reached, so building the
+    // index takes O(n) expected time for n distinct nodes in all the lists,
+    // however many they share. A list's nodes not in any earlier list are
+    // its own. Every list after its own nodes joins some earlier list (its
+    // parent) or ends, so the lists form a forest, and two lists meet in the
+    // lowest common ancestor of the two, at the later of the places where
+    // they enter it. Finding that takes O(log k) time for k lists.
+    //
+    // The lists must be acyclic. Like a List<T>, the index doesn't own the
+    // nodes, and relinking them makes it stale.
+    template<typename T>
+    class MeetIndex {
+    public:
+        template<typename I>
+        MeetIndex(I first, I last);
+
+        MeetIndex(std::initializer_list<ListNode<T>*> heads)
+            : MeetIndex(heads.begin(), heads.end()) { }
+
+        // The number of lists.
+        std::size_t size() const noexcept { return heads_.size(); }
+
+        // The first node the lists numbered i and j share, or null if none.
+        ListNode<T>* meet_node(std::size_t i, std::size_t j) const noexcept;
+
+        typename ListNode<T>::iterator
+        meet(const std::size_t i, const std::size_t j) const noexcept
+        {
+            return typename ListNode<T>::iterator{meet_node(i, j)};
+        }
+
+        // Calls f(i, j, node) for each pair of lists i < j that meet.
+        template<typename F>
+        void for_each_meet(F f) const;
+
+    private:
+        static constexpr auto none = std::numeric_limits<std::size_t>::max();
+
+        struct Slot {
+            std::size_t hash;
+            const ListNode<T>* node;
+            std::size_t index; // into nodes_
+        };
+
+        static std::size_t hash_of(const ListNode<T>* const node) noexcept
+        {
+            return detail::mix_hash(reinterpret_cast<std::uintptr_t>(node));
+        }
+
+        // The slot holding the node, or the empty slot where it would go.
+        std::size_t probe(const ListNode<T>* node, std::size_t h) const
+            noexcept;
+
+        // The list in which nodes_[index] is one of its own nodes.
+        std::size_t owner(std::size_t index) const noexcept;
+
+        // Walks up from list i to its ancestor at the given depth.
+        std::size_t lift(std::size_t i, std::size_t depth) const noexcept;
+
+        std::vector<ListNode<T>*> heads_;
+        std::vector<ListNode<T>*> nodes_;   // each list's own, in order
+        std::vector<std::size_t> offsets_;  // where each list's own begin
+        std::vector<std::size_t> entries_;  // position joined in parent
+        std::vector<std::size_t> depths_;
+        std::vector<std::size_t> roots_;
+        std::vector<std::vector<std::size_t>> ancestors_; // 2**level up
+        std::vector<Slot> slots_;
+    };
+
+    template<typename T>
+    template<typename I>
+    MeetIndex<T>::MeetIndex(I first, const I last)
+        : heads_(first, last)
+    {
+        const auto k = heads_.size();
+        offsets_.reserve(k + 1u);
+        entries_.assign(k, 0u);
+        depths_.assign(k, 0u);
+        roots_.resize(k);
+        ancestors_.emplace_back(k, none);
+        detail::reserve_slots(slots_, 0u);
+
+        for (auto i = std::size_t{0u}; i != k; ++i) {
+            offsets_.push_back(nodes_.size());
+            roots_[i] = i;
+
+            for (auto node = heads_[i]; node; node = node->next) {
+                const auto h = hash_of(node);
+                const auto slot = probe(node, h);
+
+                if (slots_[slot].node) {
+                    const auto index = slots_[slot].index;
+                    const auto parent = owner(index);
+                    if (parent == i)
+                        throw std::invalid_argument{"list has a cycle"};
+
+                    ancestors_[0][i] = parent;
+                    entries_[i] = index - offsets_[parent];
+                    depths_[i] = depths_[parent] + 1u;
+                    roots_[i] = roots_[parent];
+                    break;
+                }
+
+                nodes_.push_back(node);
+                slots_[slot] = {h, node, nodes_.size() - 1u};
+                detail::reserve_slots(slots_, nodes_.size());
+            }
+        }
+
+        offsets_.push_back(nodes_.size());
+
+        // Binary lifting: ancestors_[level][i] is 2**level generations up.
+        const auto max_depth = k == 0u ? std::size_t{0u}
+                                       : *std::max_element(cbegin(depths_),
+                                                           cend(depths_));
+
+        for (auto span = std::size_t{2u}; span <= max_depth; span *= 2u) {
+            const auto& half = ancestors_.back();
+            std::vector<std::size_t> full (k, none);
+
+            for (auto i = std::size_t{0u}; i != k; ++i)
+                if (half[i] != none) full[i] = half[half[i]];
+
+            ancestors_.push_back(std::move(full));
+        }
+    }
+
+    template<typename T>
+    ListNode<T>* MeetIndex<T>::meet_node(std::size_t i, std::size_t j) const
+        noexcept
+    {
+        if (!heads_[i] || !heads_[j] || roots_[i] != roots_[j])
+            return nullptr;
+        if (i == j) return heads_[i];
+
+        if (depths_[i] < depths_[j]) std::swap(i, j);
+
+        // Bring i up to j's depth. If j is then i's ancestor, they meet where
+        // i's line enters j. (A list with no nodes of its own has no
+        // descendants, so here j's first own node is its head.)
+        if (depths_[i] != depths_[j]) {
+            i = lift(i, depths_[j] + 1u);
+            const auto parent = ancestors_[0][i];
+            if (parent == j) return nodes_[offsets_[j] + entries_[i]];
+            i = parent;
+        }
+
+        for (auto level = ancestors_.size(); level-- != 0u; ) {
+            if (ancestors_[level][i] != ancestors_[level][j]) {
+                i = ancestors_[level][i];
+                j = ancestors_[level][j];
+            }
+        }
+
+        const auto parent = ancestors_[0][i];
+        return nodes_[offsets_[parent] + std::max(entries_[i], entries_[j])];
+    }
+
+    template<typename T>
+    template<typename F>
+    void MeetIndex<T>::for_each_meet(F f) const
+    {
+        for (auto i = std::size_t{0u}; i != heads_.size(); ++i) {
+            for (auto j = i + 1u; j != heads_.size(); ++j)
+                if (const auto node = meet_node(i, j)) f(i, j, node);
+        }
+    }
+
+    template<typename T>
+    std::size_t MeetIndex<T>::probe(const ListNode<T>* const node,
+                                    const std::size_t h) const noexcept
+    {
+        return detail::probe_slot(slots_, h, [node](const Slot& slot) {
+            return slot.node == node;
+        });
+    }
+
+    template<typename T>
+    std::size_t MeetIndex<T>::owner(const std::size_t index) const noexcept
+    {
+        // The last list whose own nodes begin at or before index. Lists with
+        // no nodes of their own begin where the next list does, so take the
+        // last of any run of equal offsets.
+        return static_cast<std::size_t>(
+                std::upper_bound(cbegin(offsets_), cend(offsets_), index)
+                    - cbegin(offsets_)) - 1u;
+    }
+
+    template<typename T>
+    std::size_t MeetIndex<T>::lift(std::size_t i, const std::size_t depth) const
+        noexcept
+    {
+        for (auto level = std::size_t{0u}, up = depths_[i] - depth; up != 0u;
+                ++level, up /= 2u) {
+            if (up % 2u != 0u) i = ancestors_[level][i];
+        }
+
+        return i;
+    }
+}
+
+#endif // ! HAVE_POOL_MEETINDEX_HPP_
@@ -0,0 +1,237 @@
+// Implementation of tests of parallel list ranking, prefix folds, and
+// algorithms on chunk-indexed lists.
+//
+// Copyright (c) 2018 Eliah Kagan
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+// SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+// OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+// CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include "Parallel-test.hpp"
+
+#include "ChunkIndex.hpp"
+#include "List.hpp"
+#include "Parallel.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    using ek::ChunkIndex, ek::List, ek::ListNode, ek::Pool;
+
+    // Makes count nodes, then links them, in shuffled order, into lists of
+    // the given lengths (which must add up to count). Returns the heads.
+    template<typename T>
+    std::vector<ListNode<T>*>
+    make_lists(Pool<ListNode<T>>& pool, const std::vector<T>& keys,
+               const std::vector<std::size_t>& lengths)
+    {
+        for (const auto& key : keys) pool(key, nullptr);
+
+        std::vector<std::size_t> slots (keys.size());
+        std::iota(begin(slots), end(slots), std::size_t{0u});
+        std::shuffle(begin(slots), end(slots), std::mt19937{12345u});
+
+        std::vector<ListNode<T>*> heads;
+        auto slot = cbegin(slots);
+
+        for (const auto length : lengths) {
+            ListNode<T>** destp = &heads.emplace_back();
+
+            for (auto i = length; i != 0u; --i) {
+                *destp = &pool[*slot++];
+                destp = &(*destp)->next;
+            }
+        }
+
+        return heads;
+    }
+
+    void test_rank_lists()
+    {
+        std::vector<int> keys (10'000);
+        std::iota(begin(keys), end(keys), 0);
+
+        Pool<ListNode<int>> pool;
+        const auto heads = make_lists(pool, keys, {1u, 6'000u, 2u, 3'997u});
+
+        for (const auto threads : {1u, 2u, 3u, 8u}) {
+            const auto ranks = ek::rank_lists(pool, threads);
+
+            for (const auto head : heads) {
+                auto length = std::size_t{0u};
+                for (auto node = head; node; node = node->next) ++length;
+
+                auto index = std::size_t{0u};
+                for (auto node = head; node; node = node->next, ++index) {
+                    const auto slot = static_cast<std::size_t>(node->key);
+                    assert(ranks.index[slot] == index);
+                    assert(ranks.distance[slot] == length - index - 1u);
+                }
+            }
+        }
+
+        std::cout << "rank_lists agrees with sequential walks of "
+                  << heads.size() << " lists of " << keys.size()
+                  << " nodes\n";
+    }
+
+    void test_prefix_fold()
+    {
+        std::vector<std::string> keys;
+        for (auto i = 0; i != 3'000; ++i) keys.push_back(std::to_string(i % 7));
+
+        Pool<ListNode<std::string>> pool;
+        const auto heads = make_lists(pool, keys, {1'500u, 1u, 1'499u});
+
+        // Concatenation is associative but not commutative, so this checks
+        // that the pieces are combined in order.
+        const auto concat = [](const std::string& lhs,
+                               const std::string& rhs) {
+            return lhs + rhs;
+        };
+
+        std::unordered_map<const ListNode<std::string>*, std::size_t> slots;
+        for (auto slot = std::size_t{0u}; slot != pool.size(); ++slot)
+            slots.emplace(&pool[slot], slot);
+
+        for (const auto threads : {1u, 2u, 3u, 8u}) {
+            const auto folds = ek::prefix_fold(pool, concat, threads);
+
+            for (const auto head : heads) {
+                std::string acc;
+
+                for (auto node = head; node; node = node->next) {
+                    acc += node->key;
+                    assert(folds[slots.at(node)] == acc);
+                }
+            }
+        }
+
+        std::cout << "prefix_fold agrees with sequential walks of "
+                  << heads.size() << " lists of " << keys.size()
+                  << " nodes\n";
+    }
+
+    void test_empty()
+    {
+        const Pool<ListNode<int>> pool;
+        assert(ek::rank_lists(pool).index.empty());
+        assert(ek::prefix_fold(pool, std::plus<>{}).empty());
+    }
+
+    void test_chunk_index()
+    {
+        Pool<ListNode<int>> pool;
+        std::vector<int> keys (10'000);
+        std::iota(begin(keys), end(keys), 0);
+        const List<int> list {pool, keys};
+
+        const ChunkIndex<int> by_list {list};
+        const ChunkIndex<int> by_head {list.head()};
+        assert(by_list.stride() == 100u && by_list.chunk_count() == 100u);
+        assert(by_head.stride() * by_head.stride() / 4u <= keys.size());
+        assert(by_head.chunk_count() <= by_head.stride() * 2u + 1u);
+
+        for (auto pos = std::size_t{0u}; pos != keys.size(); ++pos)
+            assert(by_list[pos] == keys[pos] && by_head[pos] == keys[pos]);
+
+        auto threw = false;
+        try {
+            by_head.at(keys.size());
+        } catch (const std::out_of_range&) {
+            threw = true;
+        }
+        assert(threw);
+
+        for (const auto threads : {1u, 2u, 3u, 8u}) {
+            ek::parallel_for_each(by_head, [](int& key) { key *= 2; },
+                                  threads);
+
+            const auto sum = ek::parallel_fold(by_list, 0, std::plus<>{},
+                                               threads);
+            assert(sum == std::accumulate(cbegin(list), cend(list), 0));
+
+            ek::parallel_for_each(by_list, [](int& key) { key /= 2; },
+                                  threads);
+
+            assert(*ek::parallel_find_if(by_head, [](const int key) {
+                return key % 2'503 == 0;
+            }, threads) == 0);
+            assert(*ek::parallel_find_if(by_head, [](const int key) {
+                return key > 0 && key % 2'503 == 0;
+            }, threads) == 2'503);
+            assert(ek::parallel_find_if(by_head, [](const int key) {
+                return key == 9'999;
+            }, threads) == List<int>::iterator{list.tail()});
+            assert(ek::parallel_find_if(by_head, [](int) { return false; },
+                                        threads) == end(list));
+
+            assert(ek::parallel_equal(by_list, by_head, threads));
+        }
+
+        // Concatenation checks that the parts are folded in order.
+        Pool<ListNode<std::string>> strings;
+        List<std::string> digits;
+        for (const auto key : keys)
+            digits.push_back(strings(std::to_string(key % 10), nullptr));
+
+        const ChunkIndex<std::string> digit_index {digits.head()};
+        const auto concat = [](const std::string& lhs,
+                               const std::string& rhs) {
+            return lhs + rhs;
+        };
+
+        std::string expected = ">";
+        for (const auto key : keys) expected += std::to_string(key % 10);
+
+        for (const auto threads : {1u, 3u, 8u}) {
+            assert(ek::parallel_fold(digit_index, std::string{">"}, concat,
+                                     threads) == expected);
+
+            keys.back() = -1;
+            const ChunkIndex<int> other {List<int>{pool, keys}};
+            assert(!ek::parallel_equal(by_list, other, threads));
+            keys.back() = 9'999;
+
+            assert(ek::parallel_equal(digit_index, by_head,
+                                      [](const std::string& digit,
+                                         const int key) {
+                return digit == std::to_string(key % 10);
+            }, threads));
+        }
+
+        const ChunkIndex<int> empty {static_cast<ListNode<int>*>(nullptr)};
+        assert(empty.size() == 0u && empty.chunk_count() == 0u);
+        assert(ek::parallel_fold(empty, 5, std::plus<>{}) == 5);
+        assert(ek::parallel_equal(empty, ChunkIndex<int>{List<int>{}}));
+
+        std::cout << "chunk index of " << by_head.size() << " nodes has "
+                  << by_head.chunk_count() << " chunks of "
+                  << by_head.stride() << " nodes\n";
+    }
+}
+
+void run_parallel_tests()
+{
+    test_rank_lists();
+    test_prefix_fold();
+    test_empty();
+    test_chunk_index();
+}
@@ -0,0 +1,4 @@
+// Parallel algorithms on the ListNode lists in a Pool.
+// SPDX-License-Identifier: 0BSD
+
+#include "Parallel.hpp"
@@ -0,0 +1,355 @@
+// Parallel algorithms on the ListNode lists in a Pool.
+//
+// Copyright (c) 2018 Eliah Kagan
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+// SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+// OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+// CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef HAVE_POOL_PARALLEL_HPP_
+#define HAVE_POOL_PARALLEL_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "ListNode.hpp"
+#include "Pool.hpp"
+
+namespace ek {
+    namespace detail {
+        inline unsigned thread_count(const unsigned requested) noexcept
+        {
+            if (requested != 0u) return requested;
+
+            const auto available = std::thread::hardware_concurrency();
+            return available != 0u ? available : 1u;
+        }
+
+        // Splits [0, n) into at most the given number of contiguous parts of
+        // nearly equal size, and calls f(first, last) for each in parallel.
+        template<typename F>
+        void parallel_for(const std::size_t n, const unsigned threads, F f)
+        {
+            const auto parts = std::max(std::size_t{1u},
+                                        std::min(std::size_t{threads}, n));
+
+            std::vector<std::thread> workers;
+            workers.reserve(parts - 1u);
+
+            for (auto part = std::size_t{1u}; part != parts; ++part)
+                workers.emplace_back(f, n * part / parts,
+                                     n * (part + 1u) / parts);
+
+            f(std::size_t{0u}, n / parts);
+
+            for (auto& worker : workers) worker.join();
+        }
+
+        // Maps the address of an object in a Pool to its slot. A Pool's
+        // objects are stored in contiguous blocks, so this finds the block by
+        // binary search and then the slot by pointer arithmetic.
+        template<typename T>
+        class SlotMap {
+        public:
+            explicit SlotMap(const Pool<T>& pool);
+
+            std::size_t operator()(const T* p) const noexcept;
+
+        private:
+            std::vector<std::pair<const T*, std::size_t>> blocks_;
+        };
+
+        template<typename T>
+        SlotMap<T>::SlotMap(const Pool<T>& pool)
+        {
+            for (auto slot = std::size_t{0u}; slot != pool.size(); ++slot) {
+                if (slot == 0u || &pool[slot] != &pool[slot - 1u] + 1)
+                    blocks_.emplace_back(&pool[slot], slot);
+            }
+
+            std::sort(begin(blocks_), end(blocks_),
+                      [](const auto& lhs, const auto& rhs) {
+                return std::less<const T*>{}(lhs.first, rhs.first);
+            });
+        }
+
+        template<typename T>
+        std::size_t SlotMap<T>::operator()(const T* const p) const noexcept
+        {
+            const auto block = std::prev(std::upper_bound(
+                    cbegin(blocks_), cend(blocks_), p,
+                    [](const T* const q, const auto& blk) {
+                        return std::less<const T*>{}(q, blk.first);
+                    }));
+
+            return block->second + static_cast<std::size_t>(p - block->first);
+        }
+
+        // Splits the lists in a pool into sublists at every list head and at
+        // some randomly chosen nodes, ranks each node within its sublist in
+        // parallel, then ranks the (few) sublists sequentially. This random
+        // splitter contraction does O(n) work, unlike pointer jumping.
+        template<typename T>
+        class ListContraction {
+        public:
+            static constexpr auto none =
+                    std::numeric_limits<std::size_t>::max();
+
+            ListContraction(const Pool<ListNode<T>>& pool, unsigned threads);
+
+            unsigned threads() const noexcept { return threads_; }
+
+            // Calls f(slot, previous slot) for every node, or f(slot, none)
+            // for the first node of a sublist. Sublists are visited in
+            // parallel, and each sublist's nodes are visited in order.
+            template<typename F>
+            void walk_sublists(F f) const;
+
+            // The index of the sublist's first node in its list.
+            std::size_t offset(const std::size_t sublist) const noexcept
+            {
+                return offsets_[sublist];
+            }
+
+            // The length of the whole list the sublist is in.
+            std::size_t length(const std::size_t sublist) const noexcept
+            {
+                return lengths_[sublist];
+            }
+
+            std::size_t owner(const std::size_t slot) const noexcept
+            {
+                return owners_[slot];
+            }
+
+            std::size_t position(const std::size_t slot) const noexcept
+            {
+                return positions_[slot];
+            }
+
+            std::size_t last(const std::size_t sublist) const noexcept
+            {
+                return lasts_[sublist];
+            }
+
+            // Sublists, each list's in order, with lists one after another.
+            const std::vector<std::size_t>& order() const noexcept
+            {
+                return order_;
+            }
+
+            bool starts_list(const std::size_t sublist) const noexcept
+            {
+                return offsets_[sublist] == 0u;
+            }
+
+        private:
+            unsigned threads_;
+            std::vector<std::size_t> succ_;
+            std::vector<std::size_t> sublist_at_;
+            std::vector<std::size_t> firsts_;
+            std::vector<std::size_t> lasts_;
+            std::vector<std::size_t> nexts_;
+            std::vector<std::size_t> owners_;
+            std::vector<std::size_t> positions_;
+            std::vector<std::size_t> offsets_;
+            std::vector<std::size_t> lengths_;
+            std::vector<std::size_t> order_;
+        };
+
+        template<typename T>
+        ListContraction<T>::ListContraction(const Pool<ListNode<T>>& pool,
+                                            const unsigned threads)
+            : threads_{thread_count(threads)},
+              succ_(pool.size()), sublist_at_(pool.size(), none),
+              owners_(pool.size()), positions_(pool.size())
+        {
+            const auto n = pool.size();
+            const SlotMap<ListNode<T>> slot_of {pool};
+
+            std::vector<unsigned char> has_pred (n);
+
+            // The lists are disjoint, so no two threads write the same flag.
+            parallel_for(n, threads_, [&](std::size_t first,
+                                          const std::size_t last) {
+                for (; first != last; ++first) {
+                    const auto next = pool[first].next;
+                    succ_[first] = (next ? slot_of(next) : none);
+                    if (next) has_pred[succ_[first]] = 1u;
+                }
+            });
+
+            const auto add_splitter = [this](const std::size_t slot) {
+                if (sublist_at_[slot] != none) return;
+                sublist_at_[slot] = firsts_.size();
+                firsts_.push_back(slot);
+            };
+
+            for (auto slot = std::size_t{0u}; slot != n; ++slot)
+                if (!has_pred[slot]) add_splitter(slot);
+
+            if (n != 0u) {
+                std::mt19937_64 gen {n};
+                std::uniform_int_distribution<std::size_t> pick {0u, n - 1u};
+                for (auto i = std::size_t{threads_} * 64u; i != 0u; --i)
+                    add_splitter(pick(gen));
+            }
+
+            const auto sublists = firsts_.size();
+            lasts_.resize(sublists);
+            nexts_.resize(sublists);
+
+            parallel_for(sublists, threads_, [&](std::size_t first,
+                                                 const std::size_t last) {
+                for (; first != last; ++first) {
+                    auto slot = firsts_[first];
+                    auto pos = std::size_t{0u};
+
+                    for (; ; ++pos) {
+                        owners_[slot] = first;
+                        positions_[slot] = pos;
+
+                        const auto next = succ_[slot];
+                        if (next == none || sublist_at_[next] != none) {
+                            lasts_[first] = slot;
+                            nexts_[first] = (next == none ? none
+                                                          : sublist_at_[next]);
+                            break;
+                        }
+
+                        slot = next;
+                    }
+                }
+            });
+
+            // Only now do we go through each list's sublists in order.
+            offsets_.resize(sublists);
+            lengths_.resize(sublists);
+            order_.reserve(sublists);
+
+            for (auto head = std::size_t{0u}; head != sublists; ++head) {
+                if (has_pred[firsts_[head]]) continue;
+
+                const auto start = order_.size();
+                auto offset = std::size_t{0u};
+
+                for (auto sub = head; sub != none; sub = nexts_[sub]) {
+                    order_.push_back(sub);
+                    offsets_[sub] = offset;
+                    offset += positions_[lasts_[sub]] + 1u;
+                }
+
+                for (auto i = start; i != order_.size(); ++i)
+                    lengths_[order_[i]] = offset;
+            }
+        }
+
+        template<typename T>
+        template<typename F>
+        void ListContraction<T>::walk_sublists(F f) const
+        {
+            parallel_for(firsts_.size(), threads_, [&](std::size_t first,
+                                                       const std::size_t last) {
+                for (; first != last; ++first) {
+                    auto prev = none;
+                    for (auto slot = firsts_[first]; ; slot = succ_[slot]) {
+                        f(slot, prev);
+                        if (slot == lasts_[first]) break;
+                        prev = slot;
+                    }
+                }
+            });
+        }
+    }
+
+    // Where each node is in its list, indexed by pool slot.
+    struct ListRanks {
+        std::vector<std::size_t> index;     // number of nodes before it
+        std::vector<std::size_t> distance;  // number of nodes after it
+    };
+
+    // The parallel list algorithms take all the lists in a pool at once. The
+    // lists must be disjoint and acyclic, and their links must all be null or
+    // point into the same pool. Results go in vectors indexed by pool slot.
+    // Using 0 threads means using std::thread::hardware_concurrency() threads.
+    template<typename T>
+    ListRanks rank_lists(const Pool<ListNode<T>>& pool,
+                         const unsigned threads = 0u)
+    {
+        const detail::ListContraction<T> lists {pool, threads};
+
+        ListRanks ret {std::vector<std::size_t>(pool.size()),
+                       std::vector<std::size_t>(pool.size())};
+
+        detail::parallel_for(pool.size(), lists.threads(),
+                             [&](std::size_t first, const std::size_t last) {
+            for (; first != last; ++first) {
+                const auto sub = lists.owner(first);
+                const auto index = lists.offset(sub) + lists.position(first);
+                ret.index[first] = index;
+                ret.distance[first] = lists.length(sub) - index - 1u;
+            }
+        });
+
+        return ret;
+    }
+
+    // For each node, the fold by f (which must be associative) of the keys
+    // from its list's head through that node. T must be default constructible
+    // and copy assignable.
+    template<typename T, typename F>
+    std::vector<T> prefix_fold(const Pool<ListNode<T>>& pool, F f,
+                               const unsigned threads = 0u)
+    {
+        const detail::ListContraction<T> lists {pool, threads};
+
+        std::vector<T> ret (pool.size());
+
+        // Fold within each sublist.
+        lists.walk_sublists([&](const std::size_t slot,
+                                const std::size_t prev) {
+            const auto& key = pool[slot].key;
+            ret[slot] = (prev == lists.none ? key : f(ret[prev], key));
+        });
+
+        // Fold the sublists' totals in order, to find what precedes each.
+        std::vector<T> before (lists.order().size());
+        T carry {};
+
+        for (const auto sub : lists.order()) {
+            const auto& total = ret[lists.last(sub)];
+
+            if (lists.starts_list(sub)) {
+                carry = total;
+            } else {
+                before[sub] = carry;
+                carry = f(carry, total);
+            }
+        }
+
+        detail::parallel_for(pool.size(), lists.threads(),
+                             [&](std::size_t first, const std::size_t last) {
+            for (; first != last; ++first) {
+                const auto sub = lists.owner(first);
+                if (!lists.starts_list(sub))
+                    ret[first] = f(before[sub], ret[first]);
+            }
+        });
+
+        return ret;
+    }
+}
+
+#endif // ! HAVE_POOL_PARALLEL_HPP_
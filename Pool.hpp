@@ -17,10 +17,27 @@
 #ifndef HAVE_POOL_POOL_HPP_
 #define HAVE_POOL_POOL_HPP_
 
+#include <cstddef>
 #include <deque>
+#include <type_traits>
 #include <utility>
 
 namespace ek {
+    namespace detail {
+        // Makes a T from args, with parentheses if T has such a constructor,
+        // else with braces, so aggregates can be built from their members.
+        // The result is a prvalue, so a member initialized from it is built
+        // in place, even if T can't be copied or moved.
+        template<typename T, typename... Args>
+        constexpr T construct(Args&&... args)
+        {
+            if constexpr (std::is_constructible_v<T, Args...>)
+                return T(std::forward<Args>(args)...);
+            else
+                return T{std::forward<Args>(args)...};
+        }
+    }
+
     template<typename T>
     class Pool {
     public:
@@ -30,6 +47,19 @@ namespace ek {
             return &objects_.emplace_back(std::forward<Args>(args)...);
         }
 
+        // Objects are in slots numbered in the order they were made.
+        std::size_t size() const noexcept { return objects_.size(); }
+
+        T& operator[](const std::size_t slot) noexcept
+        {
+            return objects_[slot];
+        }
+
+        const T& operator[](const std::size_t slot) const noexcept
+        {
+            return objects_[slot];
+        }
+
     private:
         std::deque<T> objects_;
     };
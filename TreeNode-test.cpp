@@ -15,10 +15,22 @@
 
 #include "TreeNode-test.hpp"
 
+#include "BatchFind.hpp"
 #include "Pool.hpp"
 #include "TreeNode.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace {
     using ek::Pool, ek::TreeNode;
@@ -185,9 +197,112 @@ namespace {
         print_inorder_rec_iter(s0);
         print_postorder_rec_iter(s0);
     }
+
+    void test_clone_tree()
+    {
+        Pool<TreeNode<int>> p;
+
+        auto r = p(10, p(20, p(40), p(50, p(80), nullptr)),
+                       p(30, nullptr, p(70)));
+
+        Pool<TreeNode<int>> q;
+        const auto copy = clone_tree(q, static_cast<const TreeNode<int>*>(r));
+
+        // The copies are in preorder in the new pool.
+        const int keys[] {10, 20, 40, 50, 80, 30, 70};
+        assert(q.size() == std::size(keys) && copy == &q[0u]);
+        for (auto slot = std::size_t{0u}; slot != q.size(); ++slot)
+            assert(q[slot].key == keys[slot]);
+
+        r->left->right->left->key = 0;
+        assert(copy->left->right->left->key == 80);
+        assert(!copy->right->left && copy->right->right->key == 70);
+
+        // Deep trees are cloned without recursion.
+        TreeNode<int>* deep {};
+        for (auto i = 0; i != 100'000; ++i) deep = p(i, deep, nullptr);
+        auto node = clone_tree(q, static_cast<const TreeNode<int>*>(deep));
+        for (auto i = 100'000; i-- != 0; node = node->left)
+            assert(node->key == i && !node->right);
+        assert(!node);
+
+        print_preorder_iter(copy);
+    }
+
+    void test_emplace_tree()
+    {
+        using std::string;
+
+        // The key is built in place from the constructor arguments.
+        Pool<TreeNode<string>> p;
+        const auto leaf = p(std::in_place, nullptr, nullptr, 3u, 'b');
+        const auto root = p(std::in_place, leaf, nullptr, "root");
+        assert(root->key == "root" && root->left->key == "bbb");
+        assert(!root->right && !leaf->left && !leaf->right);
+
+        // The key type need not be copyable or movable.
+        Pool<TreeNode<std::atomic<int>>> q;
+        const auto counter = q(std::in_place, nullptr, nullptr, 5);
+        assert(++counter->key == 6);
+    }
+
+    void test_tree_find()
+    {
+        // A search tree from keys inserted in random order, so it has some
+        // depth, with nodes in the order they were inserted.
+        Pool<TreeNode<int>> p;
+        TreeNode<int>* root {};
+
+        std::vector<int> keys (500);
+        std::iota(begin(keys), end(keys), 0);
+        std::shuffle(begin(keys), end(keys), std::mt19937{50u});
+
+        for (const auto key : keys) {
+            auto destp = &root;
+            while (*destp)
+                destp = &(key < (*destp)->key ? (*destp)->left
+                                              : (*destp)->right);
+            *destp = p(key);
+        }
+
+        for (const auto key : keys) assert(tree_find(root, key)->key == key);
+        assert(!tree_find(root, -1) && !tree_find(root, 500));
+
+        std::vector<int> probes (1000);
+        std::iota(begin(probes), end(probes), -250);
+
+        for (const std::size_t group : {1u, 5u, 16u, 2000u}) {
+            const auto found = ek::tree_find_nodes(root, cbegin(probes),
+                                                   cend(probes),
+                                                   std::less{}, group);
+
+            for (auto i = std::size_t{0u}; i != probes.size(); ++i)
+                assert(found[i] == tree_find(root, probes[i]));
+        }
+
+        // Trees ordered otherwise, through const nodes.
+        const auto desc = static_cast<const TreeNode<int>*>(
+                p(5, p(8, p(9), p(6)), p(2)));
+
+        const std::vector desc_probes {6, 7, 2, 9};
+        const auto found = ek::tree_find_nodes(desc, cbegin(desc_probes),
+                                               cend(desc_probes),
+                                               std::greater{});
+        assert(found[0] == desc->left->right && !found[1]);
+        assert(found[2] == desc->right && found[3] == desc->left->left);
+        assert(tree_find(desc, 9, std::greater{}) == found[3]);
+
+        assert(ek::tree_find_nodes(root, cbegin(probes),
+                                   cbegin(probes)).empty());
+        assert(!ek::tree_find_nodes(static_cast<TreeNode<int>*>(nullptr),
+                                    cbegin(probes), cend(probes))[0]);
+    }
 }
 
 void run_treenode_tests()
 {
     test_dfs_traversals();
+    test_clone_tree();
+    test_emplace_tree();
+    test_tree_find();
 }
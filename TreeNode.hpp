@@ -50,6 +50,13 @@ namespace ek {
         explicit TreeNode(T&& _key)
                 noexcept(std::is_nothrow_move_constructible_v<T>)
             : TreeNode{std::move(_key), nullptr, nullptr} { }
+
+        // Constructs the key in place from args.
+        template<typename... Args>
+        TreeNode(std::in_place_t, TreeNode* const _left,
+                 TreeNode* const _right, Args&&... args)
+            : key(detail::construct<T>(std::forward<Args>(args)...)),
+              left{_left}, right{_right} { }
     };
 
     namespace detail {
@@ -348,6 +355,72 @@ namespace ek {
         postorder_rec_iter(root, std::ref(print));
     }
 
+    // Copies a tree into a pool in preorder, so each node's copy is followed
+    // by those of its left subtree. This uses an explicit stack, so cloning
+    // a degenerate (very deep) tree doesn't overflow the call stack.
+    template<typename T>
+    TreeNode<T>* clone_tree(Pool<TreeNode<T>>& pool,
+                            const TreeNode<T>* const root)
+    {
+        TreeNode<T>* ret {};
+        std::stack<std::pair<const TreeNode<T>*, TreeNode<T>**>> pending;
+        if (root) pending.emplace(root, &ret);
+
+        while (!pending.empty()) {
+            const auto [src, destp] = pending.top();
+            pending.pop();
+
+            *destp = pool(src->key, nullptr, nullptr);
+            if (src->right) pending.emplace(src->right, &(*destp)->right);
+            if (src->left) pending.emplace(src->left, &(*destp)->left);
+        }
+
+        return ret;
+    }
+
+    namespace detail {
+        template<typename P, typename U, typename F>
+        P tree_find(P root, const U& key, const F f)
+        {
+            while (root) {
+                if (f(key, root->key)) root = root->left;
+                else if (f(root->key, key)) root = root->right;
+                else break;
+            }
+
+            return root;
+        }
+    }
+
+    // Searches a binary search tree ordered by f for a node whose key is
+    // equivalent to key. Returns null if there is none.
+    template<typename T, typename U, typename F>
+    inline const TreeNode<T>*
+    tree_find(const TreeNode<T>* const root, const U& key, const F f)
+    {
+        return detail::tree_find(root, key, f);
+    }
+
+    template<typename T, typename U, typename F>
+    inline TreeNode<T>*
+    tree_find(TreeNode<T>* const root, const U& key, const F f)
+    {
+        return detail::tree_find(root, key, f);
+    }
+
+    template<typename T, typename U>
+    inline const TreeNode<T>*
+    tree_find(const TreeNode<T>* const root, const U& key)
+    {
+        return detail::tree_find(root, key, std::less{});
+    }
+
+    template<typename T, typename U>
+    inline TreeNode<T>* tree_find(TreeNode<T>* const root, const U& key)
+    {
+        return detail::tree_find(root, key, std::less{});
+    }
+
     // TODO: provide preorder, inorder, postorder, and levelorder iterators
 }
 
@@ -0,0 +1,4 @@
+// Lazy views over ListNode lists that mostly fuse into a single traversal.
+// SPDX-License-Identifier: 0BSD
+
+#include "View.hpp"
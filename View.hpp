@@ -0,0 +1,368 @@
+// Lazy views over ListNode lists (and other iterator ranges) that fuse into
+// a single traversal (except chunk views), and sinks that consume them.
+//
+// Copyright (c) 2018 Eliah Kagan
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+// SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+// OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+// CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef HAVE_POOL_VIEW_HPP_
+#define HAVE_POOL_VIEW_HPP_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "List.hpp"
+#include "ListNode.hpp"
+
+namespace ek {
+    // A view is a cursor: done() tells if it is exhausted, get() accesses the
+    // current element, and advance() moves to the next. If a view knows how
+    // many elements it has left, size_hint() returns that. Copying a view
+    // makes an independent cursor at the same position. Nothing is computed
+    // until a sink (fold, count, for_each, or collect) pulls elements through.
+    template<typename I>
+    class RangeView {
+    public:
+        constexpr RangeView(const I first, const I last,
+                            const std::optional<std::size_t> size = {})
+                noexcept
+            : first_{first}, last_{last}, size_{size} { }
+
+        constexpr bool done() const noexcept { return first_ == last_; }
+
+        constexpr decltype(auto) get() const { return *first_; }
+
+        constexpr void advance()
+        {
+            ++first_;
+            if (size_) --*size_;
+        }
+
+        constexpr std::optional<std::size_t> size_hint() const noexcept
+        {
+            return size_;
+        }
+
+    private:
+        I first_;
+        I last_;
+        std::optional<std::size_t> size_;
+    };
+
+    template<typename T>
+    constexpr RangeView<typename ListNode<T>::const_iterator>
+    view(const ListNode<T>* const head) noexcept
+    {
+        return {cbegin(head), cend(head)};
+    }
+
+    template<typename T>
+    constexpr RangeView<typename ListNode<T>::iterator>
+    view(ListNode<T>* const head) noexcept
+    {
+        return {begin(head), end(head)};
+    }
+
+    template<typename T>
+    constexpr RangeView<typename List<T>::iterator>
+    view(const List<T>& list) noexcept
+    {
+        return {begin(list), end(list), list.size()};
+    }
+
+    // A filter view skips rejected elements only when it is next looked at,
+    // so making or advancing one calls the predicate on nothing.
+    template<typename V, typename F>
+    class FilterView {
+    public:
+        constexpr FilterView(const V base, const F f) : base_{base}, f_{f} { }
+
+        constexpr bool done() const
+        {
+            skip();
+            return base_.done();
+        }
+
+        constexpr decltype(auto) get() const
+        {
+            skip();
+            return base_.get();
+        }
+
+        constexpr void advance()
+        {
+            skip();
+            base_.advance();
+            skipped_ = false;
+        }
+
+        constexpr std::optional<std::size_t> size_hint() const noexcept
+        {
+            return std::nullopt;
+        }
+
+    private:
+        constexpr void skip() const
+        {
+            if (skipped_) return;
+            while (!base_.done() && !f_(base_.get())) base_.advance();
+            skipped_ = true;
+        }
+
+        mutable V base_;
+        mutable F f_;
+        mutable bool skipped_ {};
+    };
+
+    template<typename V, typename F>
+    class TransformView {
+    public:
+        constexpr TransformView(const V base, const F f)
+            : base_{base}, f_{f} { }
+
+        constexpr bool done() const { return base_.done(); }
+
+        constexpr decltype(auto) get() const { return f_(base_.get()); }
+
+        constexpr void advance() { base_.advance(); }
+
+        constexpr std::optional<std::size_t> size_hint() const
+        {
+            return base_.size_hint();
+        }
+
+    private:
+        V base_;
+        F f_;
+    };
+
+    // Likewise, a take-while view tests an element only when done() is next
+    // called.
+    template<typename V, typename F>
+    class TakeWhileView {
+    public:
+        constexpr TakeWhileView(const V base, const F f)
+            : base_{base}, f_{f} { }
+
+        constexpr bool done() const
+        {
+            if (!checked_) {
+                done_ = base_.done() || !f_(base_.get());
+                checked_ = true;
+            }
+
+            return done_;
+        }
+
+        constexpr decltype(auto) get() const { return base_.get(); }
+
+        constexpr void advance()
+        {
+            base_.advance();
+            checked_ = false;
+        }
+
+        constexpr std::optional<std::size_t> size_hint() const noexcept
+        {
+            return std::nullopt;
+        }
+
+    private:
+        V base_;
+        mutable F f_;
+        mutable bool checked_ {};
+        mutable bool done_ {};
+    };
+
+    template<typename V>
+    class TakeView {
+    public:
+        constexpr TakeView(const V base, const std::size_t count)
+            : base_{base}, count_{count} { }
+
+        constexpr bool done() const { return count_ == 0u || base_.done(); }
+
+        constexpr decltype(auto) get() const { return base_.get(); }
+
+        constexpr void advance()
+        {
+            base_.advance();
+            --count_;
+        }
+
+        constexpr std::optional<std::size_t> size_hint() const
+        {
+            const auto size = base_.size_hint();
+            if (size) return std::min(*size, count_);
+            return std::nullopt;
+        }
+
+    private:
+        V base_;
+        std::size_t count_;
+    };
+
+    template<typename V1, typename V2>
+    class ZipView {
+    public:
+        constexpr ZipView(const V1 base1, const V2 base2)
+            : base1_{base1}, base2_{base2} { }
+
+        constexpr bool done() const { return base1_.done() || base2_.done(); }
+
+        constexpr auto get() const
+        {
+            return std::pair<decltype(base1_.get()), decltype(base2_.get())>{
+                    base1_.get(), base2_.get()};
+        }
+
+        constexpr void advance()
+        {
+            base1_.advance();
+            base2_.advance();
+        }
+
+        constexpr std::optional<std::size_t> size_hint() const
+        {
+            const auto size1 = base1_.size_hint(), size2 = base2_.size_hint();
+            if (size1 && size2) return std::min(*size1, *size2);
+            return std::nullopt;
+        }
+
+    private:
+        V1 base1_;
+        V2 base2_;
+    };
+
+    // Each element of a chunk view is a TakeView over the next count elements
+    // of the base view (fewer for the last chunk). Reading a chunk does not
+    // advance the chunk view, so advancing past it goes over it again. Unlike
+    // the other views, then, a chunk view takes two passes over its base.
+    template<typename V>
+    class ChunkView {
+    public:
+        constexpr ChunkView(const V base, const std::size_t count)
+            : base_{base}, count_{count}
+        {
+            assert(count != 0u);
+        }
+
+        constexpr bool done() const { return base_.done(); }
+
+        constexpr TakeView<V> get() const { return {base_, count_}; }
+
+        constexpr void advance()
+        {
+            for (auto i = count_; i != 0u && !base_.done(); --i)
+                base_.advance();
+        }
+
+        constexpr std::optional<std::size_t> size_hint() const
+        {
+            const auto size = base_.size_hint();
+            if (size) return (*size + count_ - 1u) / count_;
+            return std::nullopt;
+        }
+
+    private:
+        V base_;
+        std::size_t count_;
+    };
+
+    template<typename V, typename F>
+    constexpr FilterView<V, F> filter(const V base, const F f)
+    {
+        return {base, f};
+    }
+
+    template<typename V, typename F>
+    constexpr TransformView<V, F> transform(const V base, const F f)
+    {
+        return {base, f};
+    }
+
+    template<typename V, typename F>
+    constexpr TakeWhileView<V, F> take_while(const V base, const F f)
+    {
+        return {base, f};
+    }
+
+    template<typename V>
+    constexpr TakeView<V> take(const V base, const std::size_t count)
+    {
+        return {base, count};
+    }
+
+    template<typename V1, typename V2>
+    constexpr ZipView<V1, V2> zip(const V1 base1, const V2 base2)
+    {
+        return {base1, base2};
+    }
+
+    template<typename V>
+    constexpr ChunkView<V> chunk(const V base, const std::size_t count)
+    {
+        return {base, count};
+    }
+
+    template<typename V, typename T, typename F>
+    constexpr T fold(V v, T acc, F f)
+    {
+        for (; !v.done(); v.advance()) acc = f(std::move(acc), v.get());
+        return acc;
+    }
+
+    template<typename V>
+    constexpr std::size_t count(V v)
+    {
+        if (const auto size = v.size_hint()) return *size;
+
+        std::size_t ret {};
+        for (; !v.done(); v.advance()) ++ret;
+        return ret;
+    }
+
+    template<typename V, typename F>
+    constexpr void for_each(V v, F f)
+    {
+        for (; !v.done(); v.advance()) f(v.get());
+    }
+
+    namespace detail {
+        template<typename X>
+        struct Collected {
+            using type = std::decay_t<X>;
+        };
+
+        // Elements of a zip view refer into both bases, but collect copies.
+        template<typename X1, typename X2>
+        struct Collected<std::pair<X1, X2>> {
+            using type = std::pair<std::decay_t<X1>, std::decay_t<X2>>;
+        };
+    }
+
+    template<typename V>
+    auto collect(V v)
+    {
+        std::vector<typename detail::Collected<decltype(v.get())>::type> ret;
+        if (const auto size = v.size_hint()) ret.reserve(*size);
+
+        for (; !v.done(); v.advance()) ret.push_back(v.get());
+        return ret;
+    }
+}
+
+#endif // ! HAVE_POOL_VIEW_HPP_
@@ -0,0 +1,169 @@
+// Lookups per second of find_nodes and tree_find_nodes at several group
+// sizes, versus looking up each key in turn with find_node and tree_find,
+// in lists and a search tree whose nodes are scattered in memory.
+//
+// Copyright (c) 2018 Eliah Kagan
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+// SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+// OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+// CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include "BatchFind.hpp"
+#include "ListNode.hpp"
+#include "Pool.hpp"
+#include "TreeNode.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+    constexpr auto node_count = std::size_t{1u} << 22u;
+    constexpr auto list_count = node_count / 8u;
+    constexpr auto query_count = std::size_t{1u} << 20u;
+    constexpr std::size_t groups[] {2u, 4u, 8u, 16u, 32u};
+
+    template<typename F>
+    double nanoseconds_per_query(F f)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        const auto found = f();
+        const std::chrono::duration<double, std::nano> elapsed
+                = std::chrono::steady_clock::now() - start;
+
+        if (found == 42u) std::cout << '\n'; // Keep f() from being elided.
+        return elapsed.count() / query_count;
+    }
+
+    void print_row(const char* const name, const double single,
+                   const std::vector<double>& batched)
+    {
+        std::cout << std::fixed << std::setprecision(1)
+                  << std::setw(6) << name << std::setw(10) << single;
+        for (const auto ns : batched) std::cout << std::setw(10) << ns;
+        std::cout << '\n';
+    }
+
+    // Hash chains: lists of 8 nodes on average, with the nodes shuffled.
+    void bench_lists(std::mt19937& gen)
+    {
+        ek::Pool<ek::ListNode<unsigned>> pool;
+        std::vector<ek::ListNode<unsigned>*> nodes;
+        nodes.reserve(node_count);
+        for (auto i = std::size_t{0u}; i != node_count; ++i)
+            nodes.push_back(pool(static_cast<unsigned>(i), nullptr));
+
+        std::shuffle(begin(nodes), end(nodes), gen);
+
+        std::vector<ek::ListNode<unsigned>*> heads (list_count);
+        for (const auto node : nodes) {
+            auto& head = heads[node->key % list_count];
+            node->next = head;
+            head = node;
+        }
+
+        std::vector<ek::ListNode<unsigned>*> query_heads (query_count);
+        std::vector<unsigned> keys (query_count);
+        for (auto i = std::size_t{0u}; i != query_count; ++i) {
+            keys[i] = static_cast<unsigned>(gen() % node_count);
+            query_heads[i] = heads[keys[i] % list_count];
+        }
+
+        const auto single = nanoseconds_per_query([&] {
+            auto found = std::size_t{0u};
+            for (auto i = std::size_t{0u}; i != query_count; ++i)
+                found += (find_node(query_heads[i], keys[i]) != nullptr);
+            return found;
+        });
+
+        std::vector<double> batched;
+        for (const auto group : groups) {
+            batched.push_back(nanoseconds_per_query([&] {
+                const auto found = ek::find_nodes(cbegin(query_heads),
+                                                  cend(query_heads),
+                                                  cbegin(keys), group);
+                return static_cast<std::size_t>(
+                        std::count(cbegin(found), cend(found), nullptr));
+            }));
+        }
+
+        print_row("lists", single, batched);
+    }
+
+    // A balanced search tree, with each node in a random slot of the pool.
+    void bench_tree(std::mt19937& gen)
+    {
+        ek::Pool<ek::TreeNode<unsigned>> pool;
+        std::vector<ek::TreeNode<unsigned>*> nodes;
+        nodes.reserve(node_count);
+        for (auto i = std::size_t{0u}; i != node_count; ++i)
+            nodes.push_back(pool(0u));
+
+        std::shuffle(begin(nodes), end(nodes), gen);
+
+        auto next = begin(nodes);
+        const auto build = [&next](const auto& self, const std::size_t low,
+                                   const std::size_t high)
+                -> ek::TreeNode<unsigned>* {
+            if (low == high) return nullptr;
+
+            const auto mid = low + (high - low) / 2u;
+            const auto node = *next++;
+            node->key = static_cast<unsigned>(mid);
+            node->left = self(self, low, mid);
+            node->right = self(self, mid + 1u, high);
+            return node;
+        };
+
+        const auto root = build(build, 0u, node_count);
+
+        std::vector<unsigned> keys (query_count);
+        for (auto& key : keys) key = static_cast<unsigned>(gen() % node_count);
+
+        const auto single = nanoseconds_per_query([&] {
+            auto found = std::size_t{0u};
+            for (const auto key : keys)
+                found += (tree_find(root, key) != nullptr);
+            return found;
+        });
+
+        std::vector<double> batched;
+        for (const auto group : groups) {
+            batched.push_back(nanoseconds_per_query([&] {
+                const auto found = ek::tree_find_nodes(root, cbegin(keys),
+                                                       cend(keys),
+                                                       std::less{}, group);
+                return static_cast<std::size_t>(
+                        std::count(cbegin(found), cend(found), nullptr));
+            }));
+        }
+
+        print_row("tree", single, batched);
+    }
+}
+
+int main()
+{
+    std::mt19937 gen {12345u};
+
+    std::cout << "Nanoseconds per lookup, " << query_count << " lookups among "
+              << node_count << " nodes:\n"
+              << std::setw(6) << "" << std::setw(10) << "one by one";
+    for (const auto group : groups)
+        std::cout << std::setw(7) << "group " << std::setw(3) << group;
+    std::cout << '\n';
+
+    bench_lists(gen);
+    bench_tree(gen);
+}
@@ -0,0 +1,129 @@
+// Memory and scan time of CompressedList, versus ListNode lists with nodes
+// in allocation order and in shuffled order, for sorted keys, small keys,
+// and repetitive keys.
+//
+// Copyright (c) 2018 Eliah Kagan
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+// SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+// OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+// CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include "CompressedList.hpp"
+#include "ListNode.hpp"
+#include "Pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    constexpr auto n = std::size_t{1u} << 22u;
+    constexpr auto reps = 5;
+
+    // Returns the best time, in nanoseconds per key, of f() over reps runs.
+    template<typename F>
+    double measure(F f)
+    {
+        auto best = 0.0;
+        auto check = 0LL;
+
+        for (auto rep = 0; rep != reps; ++rep) {
+            const auto start = std::chrono::steady_clock::now();
+            check += f();
+            const std::chrono::duration<double, std::nano> elapsed
+                    = std::chrono::steady_clock::now() - start;
+
+            if (rep == 0 || elapsed.count() < best) best = elapsed.count();
+        }
+
+        if (check == 42) std::cout << '\n'; // Keep f() from being elided.
+        return best / n;
+    }
+
+    long long list_sum(const ek::ListNode<int>* head) noexcept
+    {
+        auto ret = 0LL;
+        for (; head; head = head->next) ret += head->key;
+        return ret;
+    }
+
+    void run(const std::string& name, const std::vector<int>& keys)
+    {
+        ek::Pool<ek::ListNode<int>> pool;
+        const auto in_order = make_list(pool, keys);
+
+        // Same keys in the same order, but with the nodes scattered.
+        ek::Pool<ek::ListNode<int>> scratch;
+        std::vector<ek::ListNode<int>*> nodes;
+        nodes.reserve(keys.size());
+        for (auto i = keys.size(); i != 0u; --i)
+            nodes.push_back(scratch(0, nullptr));
+
+        std::shuffle(begin(nodes), end(nodes), std::mt19937{7u});
+        for (auto i = std::size_t{0u}; i != nodes.size(); ++i)
+            nodes[i]->key = keys[i];
+        for (auto i = std::size_t{1u}; i != nodes.size(); ++i)
+            nodes[i - 1u]->next = nodes[i];
+        const auto scattered = nodes.front();
+
+        const ek::CompressedList<int> packed {cbegin(keys), cend(keys)};
+
+        const auto ordered_ns = measure([&] { return list_sum(in_order); });
+        const auto scattered_ns = measure([&] { return list_sum(scattered); });
+        const auto packed_ns = measure([&] { return packed.sum(); });
+        const auto count_ns = measure([&] {
+            return static_cast<long long>(packed.count(keys[n / 2u]));
+        });
+
+        std::cout << std::fixed << std::setprecision(2)
+                  << std::setw(11) << name
+                  << std::setw(12) << packed.bytes() * 1.0 / n
+                  << std::setw(12) << ordered_ns
+                  << std::setw(12) << scattered_ns
+                  << std::setw(12) << packed_ns
+                  << std::setw(12) << count_ns << '\n';
+    }
+}
+
+int main()
+{
+    std::mt19937 gen {12345u};
+
+    std::vector<int> sorted (n);
+    for (auto i = std::size_t{1u}; i != n; ++i)
+        sorted[i] = sorted[i - 1u] + static_cast<int>(gen() % 16u);
+
+    std::vector<int> small (n);
+    for (auto& key : small) key = static_cast<int>(gen() % 1000u);
+
+    std::vector<int> repetitive;
+    while (repetitive.size() < n)
+        repetitive.insert(end(repetitive), 1u + gen() % 200u,
+                          static_cast<int>(gen() % 10u));
+    repetitive.resize(n);
+
+    std::cout << "ListNode<int> takes " << sizeof(ek::ListNode<int>)
+              << " bytes per key. Per key, for " << n << " keys:\n"
+              << std::setw(11) << "keys"
+              << std::setw(12) << "bytes"
+              << std::setw(12) << "list ns"
+              << std::setw(12) << "shuffled ns"
+              << std::setw(12) << "sum ns"
+              << std::setw(12) << "count ns" << '\n';
+
+    run("sorted", sorted);
+    run("small", small);
+    run("repetitive", repetitive);
+}
@@ -0,0 +1,113 @@
+// Throughput of ConcurrentStack and ConcurrentQueue versus mutex-guarded
+// std::vector and std::deque, at increasing numbers of threads.
+//
+// Copyright (c) 2018 Eliah Kagan
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+// SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+// OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+// CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include "Concurrent.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace {
+    constexpr auto ops_per_thread = 200'000;
+
+    template<typename C>
+    class Locked {
+    public:
+        explicit Locked(std::size_t) { }
+
+        bool push(const int value)
+        {
+            const std::lock_guard<std::mutex> lock {mutex_};
+            items_.push_back(value);
+            return true;
+        }
+
+        std::optional<int> pop()
+        {
+            const std::lock_guard<std::mutex> lock {mutex_};
+            if (items_.empty()) return std::nullopt;
+
+            std::optional<int> ret;
+            if constexpr (std::is_same_v<C, std::deque<int>>) {
+                ret = items_.front();
+                items_.pop_front();
+            } else {
+                ret = items_.back();
+                items_.pop_back();
+            }
+
+            return ret;
+        }
+
+    private:
+        std::mutex mutex_;
+        C items_;
+    };
+
+    // Each thread alternates pushes and pops. Returns millions of operations
+    // per second.
+    template<typename C>
+    double measure(const int thread_count)
+    {
+        C container {static_cast<std::size_t>(thread_count) * 2u};
+        std::vector<std::thread> threads;
+
+        const auto start = std::chrono::steady_clock::now();
+
+        for (auto t = 0; t != thread_count; ++t) {
+            threads.emplace_back([&container, t] {
+                for (auto i = 0; i != ops_per_thread; ++i) {
+                    while (!container.push(t)) std::this_thread::yield();
+                    while (!container.pop()) std::this_thread::yield();
+                }
+            });
+        }
+
+        for (auto& thread : threads) thread.join();
+
+        const std::chrono::duration<double> elapsed
+                = std::chrono::steady_clock::now() - start;
+
+        return 2.0 * ops_per_thread * thread_count / elapsed.count() / 1e6;
+    }
+}
+
+int main()
+{
+    std::cout << "Millions of operations per second:\n"
+              << std::setw(7) << "threads"
+              << std::setw(18) << "lock-free stack"
+              << std::setw(16) << "locked vector"
+              << std::setw(18) << "lock-free queue"
+              << std::setw(15) << "locked deque" << '\n';
+
+    for (auto threads = 1; threads <= 64; threads *= 2) {
+        std::cout << std::fixed << std::setprecision(2)
+                  << std::setw(7) << threads
+                  << std::setw(18) << measure<ek::ConcurrentStack<int>>(threads)
+                  << std::setw(16) << measure<Locked<std::vector<int>>>(threads)
+                  << std::setw(18) << measure<ek::ConcurrentQueue<int>>(threads)
+                  << std::setw(15) << measure<Locked<std::deque<int>>>(threads)
+                  << '\n';
+    }
+}
@@ -0,0 +1,153 @@
+// Time and heap allocations per operation of LruCache, versus an LRU cache
+// made of std::list and std::unordered_map, at increasing capacities.
+//
+// Copyright (c) 2018 Eliah Kagan
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+// SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+// OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+// CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include "LruCache.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <new>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+    std::size_t allocations {};
+}
+
+void* operator new(const std::size_t size)
+{
+    ++allocations;
+    if (const auto p = std::malloc(size)) return p;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* const p) noexcept { std::free(p); }
+
+void operator delete(void* const p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+    constexpr auto ops = std::size_t{2'000'000u};
+
+    class StdLru {
+    public:
+        explicit StdLru(const std::size_t capacity) : capacity_{capacity}
+        {
+            index_.reserve(capacity);
+        }
+
+        int* get(const int key)
+        {
+            const auto pos = index_.find(key);
+            if (pos == end(index_)) return nullptr;
+
+            order_.splice(begin(order_), order_, pos->second);
+            return &pos->second->second;
+        }
+
+        bool put(const int key, const int value)
+        {
+            if (const auto p = get(key)) {
+                *p = value;
+                return false;
+            }
+
+            if (order_.size() == capacity_) {
+                index_.erase(order_.back().first);
+                order_.pop_back();
+            }
+
+            order_.emplace_front(key, value);
+            index_.emplace(key, begin(order_));
+            return true;
+        }
+
+    private:
+        std::size_t capacity_;
+        std::list<std::pair<int, int>> order_;
+        std::unordered_map<int, std::list<std::pair<int, int>>::iterator>
+            index_;
+    };
+
+    struct Result {
+        double nanoseconds;
+        double allocations;
+    };
+
+    // Keys are drawn from twice the capacity, so about half the gets miss
+    // and many puts evict. Each measurement follows a warm-up that fills the
+    // cache. Returns the time and allocations per operation.
+    template<typename C>
+    Result measure(const std::size_t capacity)
+    {
+        C cache {capacity};
+
+        std::mt19937 gen {12345u};
+        std::uniform_int_distribution<int> key {
+                0, static_cast<int>(capacity * 2u)};
+
+        std::vector<int> keys (ops);
+        for (auto& k : keys) k = key(gen);
+
+        for (auto i = 0; i != static_cast<int>(capacity) * 2; ++i)
+            cache.put(i, i);
+
+        const auto before = allocations;
+        const auto start = std::chrono::steady_clock::now();
+
+        auto hits = 0L;
+        for (auto i = std::size_t{0u}; i != ops; ++i) {
+            const auto k = keys[i];
+            if (i % 2u == 0u) hits += (cache.get(k) != nullptr);
+            else cache.put(k, k);
+        }
+
+        const std::chrono::duration<double, std::nano> elapsed
+                = std::chrono::steady_clock::now() - start;
+
+        if (hits < 0) std::cout << '\n'; // Keep hits from being optimized out.
+
+        return {elapsed.count() / ops,
+                static_cast<double>(allocations - before) / ops};
+    }
+}
+
+int main()
+{
+    std::cout << "Per operation, half get and half put:\n"
+              << std::setw(9) << "capacity"
+              << std::setw(14) << "LruCache ns"
+              << std::setw(14) << "allocations"
+              << std::setw(14) << "std LRU ns"
+              << std::setw(14) << "allocations" << '\n';
+
+    for (auto capacity = std::size_t{1u} << 10u;
+            capacity <= std::size_t{1u} << 20u; capacity <<= 5u) {
+        const auto lru = measure<ek::LruCache<int, int>>(capacity);
+        const auto std_lru = measure<StdLru>(capacity);
+
+        std::cout << std::fixed << std::setprecision(2)
+                  << std::setw(9) << capacity
+                  << std::setw(14) << lru.nanoseconds
+                  << std::setw(14) << lru.allocations
+                  << std::setw(14) << std_lru.nanoseconds
+                  << std::setw(14) << std_lru.allocations << '\n';
+    }
+}
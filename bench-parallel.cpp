@@ -0,0 +1,108 @@
+// Time to rank and prefix-sum the nodes of long lists whose nodes are
+// scattered through a Pool, sequentially and with rank_lists and prefix_fold
+// at increasing numbers of threads.
+//
+// Copyright (c) 2018 Eliah Kagan
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+// SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+// OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+// CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include "Parallel.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace {
+    constexpr auto node_count = std::size_t{4'000'000u};
+    constexpr auto list_count = std::size_t{4u};
+
+    using ek::ListNode, ek::Pool;
+
+    // Links the nodes of the pool into list_count lists in random order.
+    std::vector<ListNode<long long>*> scatter(Pool<ListNode<long long>>& pool)
+    {
+        for (auto i = node_count; i != 0u; --i)
+            pool(static_cast<long long>(i % 1000u), nullptr);
+
+        std::vector<std::size_t> slots (node_count);
+        std::iota(begin(slots), end(slots), std::size_t{0u});
+        std::shuffle(begin(slots), end(slots), std::mt19937_64{42u});
+
+        std::vector<ListNode<long long>*> heads (list_count);
+
+        for (auto i = std::size_t{0u}; i != node_count; ++i) {
+            auto& head = heads[i % list_count];
+            auto& node = pool[slots[i]];
+            node.next = head;
+            head = &node;
+        }
+
+        return heads;
+    }
+
+    template<typename F>
+    double milliseconds(F f)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        const std::chrono::duration<double, std::milli> elapsed
+                = std::chrono::steady_clock::now() - start;
+        return elapsed.count();
+    }
+
+    // The sequential walk stores results in list order, which needs no
+    // mapping from nodes to pool slots, so it has an advantage here.
+    double sequential(const std::vector<ListNode<long long>*>& heads)
+    {
+        std::vector<long long> sums;
+        sums.reserve(node_count);
+
+        return milliseconds([&] {
+            for (const auto head : heads) {
+                auto acc = 0LL;
+                for (auto node = head; node; node = node->next)
+                    sums.push_back(acc += node->key);
+            }
+        });
+    }
+}
+
+int main()
+{
+    Pool<ListNode<long long>> pool;
+    const auto heads = scatter(pool);
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "Milliseconds for " << node_count << " nodes in "
+              << list_count << " lists:\n"
+              << "sequential prefix sum: " << sequential(heads) << "\n\n"
+              << std::setw(7) << "threads"
+              << std::setw(12) << "rank_lists"
+              << std::setw(13) << "prefix_fold" << '\n';
+
+    for (auto threads = 1u; threads <= 16u; threads *= 2u) {
+        std::cout << std::setw(7) << threads
+                  << std::setw(12) << milliseconds([&] {
+                        ek::rank_lists(pool, threads);
+                     })
+                  << std::setw(13) << milliseconds([&] {
+                        ek::prefix_fold(pool, std::plus<>{}, threads);
+                     })
+                  << '\n';
+    }
+}
@@ -0,0 +1,116 @@
+// Average number of nodes examined per lookup with find, find_mtf, and
+// find_transpose, for keys drawn from Zipf distributions of various skews.
+//
+// Copyright (c) 2018 Eliah Kagan
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+// SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+// OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+// CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include "ListNode.hpp"
+#include "Pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace {
+    constexpr auto key_count = 1'000;
+    constexpr auto lookups = 1'000'000;
+
+    using ek::ListNode, ek::Pool;
+
+    // Keys 0, 1, 2, ... with probability proportional to 1 / (rank + 1)^s.
+    std::vector<int> zipf_keys(const double s, std::mt19937& gen)
+    {
+        std::vector<double> weights (key_count);
+        for (auto k = 0; k != key_count; ++k)
+            weights[static_cast<std::size_t>(k)] = 1.0 / std::pow(k + 1, s);
+
+        std::discrete_distribution<int> dist (cbegin(weights), cend(weights));
+
+        std::vector<int> keys (lookups);
+        for (auto& key : keys) key = dist(gen);
+        return keys;
+    }
+
+    struct Result {
+        double scanned; // average nodes examined per lookup
+        double nanoseconds;
+    };
+
+    // Looks up every key in a fresh list whose order is random, so the most
+    // frequent keys do not start near the front.
+    template<typename F>
+    Result measure(const std::vector<int>& keys, F find_node_if)
+    {
+        std::vector<int> order (key_count);
+        std::iota(begin(order), end(order), 0);
+        std::shuffle(begin(order), end(order), std::mt19937{42u});
+
+        Pool<ListNode<int>> pool;
+        auto head = ek::make_list(pool, order);
+
+        auto scanned = 0LL;
+        const auto start = std::chrono::steady_clock::now();
+
+        for (const auto key : keys) {
+            find_node_if(head, [key, &scanned](const int x) {
+                ++scanned;
+                return x == key;
+            });
+        }
+
+        const std::chrono::duration<double, std::nano> elapsed
+                = std::chrono::steady_clock::now() - start;
+
+        return {static_cast<double>(scanned) / lookups,
+                elapsed.count() / lookups};
+    }
+}
+
+int main()
+{
+    std::mt19937 gen {12345u};
+
+    std::cout << "Nodes examined (and nanoseconds) per lookup among "
+              << key_count << " keys:\n"
+              << std::setw(6) << "skew"
+              << std::setw(20) << "find"
+              << std::setw(20) << "find_mtf"
+              << std::setw(20) << "find_transpose" << '\n';
+
+    for (const auto s : {0.0, 0.8, 1.0, 1.2, 1.5}) {
+        const auto keys = zipf_keys(s, gen);
+
+        const auto plain = measure(keys, [](auto& head, const auto f) {
+            return ek::find_node_if(head, f);
+        });
+        const auto mtf = measure(keys, [](auto& head, const auto f) {
+            return ek::find_if_mtf(head, f);
+        });
+        const auto transpose = measure(keys, [](auto& head, const auto f) {
+            return ek::find_if_transpose(head, f);
+        });
+
+        std::cout << std::fixed << std::setprecision(1) << std::setw(6) << s;
+        for (const auto& result : {plain, mtf, transpose}) {
+            std::cout << std::setw(10) << result.scanned
+                      << " (" << std::setw(6) << result.nanoseconds << ')';
+        }
+        std::cout << '\n';
+    }
+}
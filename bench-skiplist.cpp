@@ -0,0 +1,134 @@
+// Throughput of ConcurrentSkipList versus a mutex-guarded std::set, at
+// increasing numbers of threads.
+//
+// Copyright (c) 2018 Eliah Kagan
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+// SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION
+// OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+// CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include "ConcurrentSkipList.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace {
+    constexpr auto key_range = 1 << 16;
+    constexpr auto total_ops = 1'600'000;
+
+    class Locked {
+    public:
+        explicit Locked(std::size_t) { }
+
+        bool insert(const int key)
+        {
+            const std::lock_guard<std::mutex> lock {mutex_};
+            return keys_.insert(key).second;
+        }
+
+        bool erase(const int key)
+        {
+            const std::lock_guard<std::mutex> lock {mutex_};
+            return keys_.erase(key) != 0u;
+        }
+
+        bool contains(const int key)
+        {
+            const std::lock_guard<std::mutex> lock {mutex_};
+            return keys_.count(key) != 0u;
+        }
+
+    private:
+        std::mutex mutex_;
+        std::set<int> keys_;
+    };
+
+    // Starts with half the keys present. The threads then share a fixed
+    // number of lookups, inserts, and erases of random keys, in the given
+    // percentages. Returns millions of operations per second.
+    template<typename C>
+    double measure(const int thread_count, const int insert_percent,
+                   const int erase_percent)
+    {
+        const auto ops_per_thread = total_ops / thread_count;
+
+        // Every insert may take a tower, and none are reclaimed meanwhile.
+        C set {static_cast<std::size_t>(key_range + total_ops / 100
+                                                    * insert_percent)};
+
+        for (auto key = 0; key < key_range; key += 2) set.insert(key);
+
+        std::vector<std::thread> threads;
+        const auto start = std::chrono::steady_clock::now();
+
+        for (auto t = 0; t != thread_count; ++t) {
+            threads.emplace_back([&, t] {
+                std::mt19937 gen {static_cast<std::mt19937::result_type>(t)};
+                std::uniform_int_distribution<int> pick_key {0, key_range - 1};
+                std::uniform_int_distribution<int> pick_op {0, 99};
+                auto found = 0;
+
+                for (auto i = 0; i != ops_per_thread; ++i) {
+                    const auto key = pick_key(gen);
+                    const auto op = pick_op(gen);
+
+                    if (op < insert_percent) found += set.insert(key);
+                    else if (op < insert_percent + erase_percent)
+                        found += set.erase(key);
+                    else found += set.contains(key);
+                }
+
+                static_cast<void>(found);
+            });
+        }
+
+        for (auto& thread : threads) thread.join();
+
+        const std::chrono::duration<double> elapsed
+                = std::chrono::steady_clock::now() - start;
+
+        return double{total_ops} / elapsed.count() / 1e6;
+    }
+
+    void report(const int insert_percent, const int erase_percent)
+    {
+        std::cout << insert_percent << "% inserts, " << erase_percent
+                  << "% erases, " << 100 - insert_percent - erase_percent
+                  << "% lookups (millions of operations per second):\n"
+                  << std::setw(7) << "threads"
+                  << std::setw(12) << "skip list"
+                  << std::setw(15) << "locked set" << '\n';
+
+        for (auto threads = 1; threads <= 64; threads *= 2) {
+            std::cout << std::fixed << std::setprecision(2)
+                      << std::setw(7) << threads
+                      << std::setw(12)
+                      << measure<ek::ConcurrentSkipList<int>>(
+                                threads, insert_percent, erase_percent)
+                      << std::setw(15)
+                      << measure<Locked>(threads, insert_percent, erase_percent)
+                      << '\n';
+        }
+    }
+}
+
+int main()
+{
+    report(10, 10);
+    std::cout << '\n';
+    report(50, 50);
+}
@@ -13,7 +13,9 @@
 
 #include <iostream>
 
+#include "Concurrent-test.hpp"
 #include "ListNode-test.hpp"
+#include "Parallel-test.hpp"
 #include "test-cfuncs.hpp"
 #include "TreeNode-test.hpp"
 
@@ -35,6 +37,10 @@ int main()
     run_listnode_tests();
     hr();
     run_treenode_tests();
+    hr();
+    run_concurrent_tests();
+    hr();
+    run_parallel_tests();
 
     std::cout << std::flush; // for convenience when debugging
 }